@@ -0,0 +1,212 @@
+#include "autocomplete.h"
+#include "traversal.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+static const uint32_t NO_ENTRY = std::numeric_limits<uint32_t>::max();
+
+static std::string foldKey(std::string_view text) {
+    std::string folded;
+    foldAssign(folded, text);
+    return folded;
+}
+
+// --- BUILD ---
+
+void AutocompleteIndex::clear() {
+    folded_.clear();
+    entries_.clear();
+    best_.clear();
+    maxKeyLength_ = 0;
+}
+
+/**
+ * @brief Collects the folded names, common names and common-name word suffixes of every
+ *        node, sorts them and builds the range-best segment tree used for top-k queries.
+ */
+void AutocompleteIndex::build(Node* root) {
+    clear();
+
+    auto addKey = [&](uint32_t offset, size_t length, KeyKind kind, Node* node) {
+        // key yang tidak muat di uint16_t tidak diindeks
+        if (length == 0 || length > std::numeric_limits<uint16_t>::max()) return;
+        entries_.push_back({offset, static_cast<uint16_t>(length), kind, node});
+        maxKeyLength_ = std::max(maxKeyLength_, length);
+    };
+
+    std::string scratch;
+    for (const TraversalEntry& entry : preOrder(root)) {
+        Node* node = entry.node;
+        uint32_t offset = static_cast<uint32_t>(folded_.size());
+        foldAssign(scratch, node->name.str());
+        folded_ += scratch;
+        addKey(offset, node->name.str().size(), KeyKind::Name, node);
+
+        std::string_view common = nodeCommonName(node);
+        if (common.empty()) continue;
+        offset = static_cast<uint32_t>(folded_.size());
+        foldAssign(scratch, common);
+        folded_ += scratch;
+        addKey(offset, common.size(), KeyKind::CommonName, node);
+        for (size_t i = 1; i < common.size(); ++i) {
+            bool wordStart = (common[i - 1] == ' ' || common[i - 1] == '-') && common[i] != ' ' && common[i] != '-';
+            if (wordStart) addKey(offset + static_cast<uint32_t>(i), common.size() - i, KeyKind::CommonWord, node);
+        }
+    }
+
+    // key sama diurutkan menurut offset, yaitu urutan pre-order
+    std::sort(entries_.begin(), entries_.end(), [this](const Entry& a, const Entry& b) {
+        std::string_view keyA(folded_.data() + a.offset, a.length);
+        std::string_view keyB(folded_.data() + b.offset, b.length);
+        int order = keyA.compare(keyB);
+        return order != 0 ? order < 0 : a.offset < b.offset;
+    });
+
+    size_t count = entries_.size();
+    best_.assign(2 * count, NO_ENTRY);
+    for (size_t i = 0; i < count; ++i) {
+        best_[count + i] = static_cast<uint32_t>(i);
+    }
+    for (size_t i = count; i-- > 1;) {
+        best_[i] = ranksBefore(best_[2 * i + 1], best_[2 * i]) ? best_[2 * i + 1] : best_[2 * i];
+    }
+}
+
+// --- QUERY ---
+
+bool AutocompleteIndex::ranksBefore(uint32_t a, uint32_t b) const {
+    if (b == NO_ENTRY) return a != NO_ENTRY;
+    if (a == NO_ENTRY) return false;
+    if (entries_[a].length != entries_[b].length) return entries_[a].length < entries_[b].length;
+    if (entries_[a].kind != entries_[b].kind) return entries_[a].kind < entries_[b].kind;
+    return a < b;
+}
+
+uint32_t AutocompleteIndex::bestInRange(uint32_t begin, uint32_t end) const {
+    uint32_t result = NO_ENTRY;
+    size_t count = entries_.size();
+    for (size_t l = begin + count, r = end + count; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            if (ranksBefore(best_[l], result)) result = best_[l];
+            ++l;
+        }
+        if (r & 1) {
+            --r;
+            if (ranksBefore(best_[r], result)) result = best_[r];
+        }
+    }
+    return result;
+}
+
+NameMatch AutocompleteIndex::makeMatch(uint32_t index, uint32_t distance) const {
+    const Entry& entry = entries_[index];
+    std::string_view text = entry.kind == KeyKind::Name ? std::string_view(entry.node->name.str())
+                                                        : nodeCommonName(entry.node);
+    return {entry.node, text, distance};
+}
+
+/**
+ * @brief Finds the prefix range by binary search, then pulls entries from it best-first
+ *        through the segment tree: O(log n + k log k) for k results.
+ */
+std::vector<NameMatch> AutocompleteIndex::complete(std::string_view prefix, size_t limit) const {
+    std::vector<NameMatch> matches;
+    if (entries_.empty() || limit == 0) return matches;
+
+    std::string folded = foldKey(prefix);
+    auto first = std::partition_point(entries_.begin(), entries_.end(), [&](const Entry& entry) {
+        return std::string_view(folded_.data() + entry.offset, entry.length) < folded;
+    });
+    auto last = std::partition_point(first, entries_.end(), [&](const Entry& entry) {
+        return std::string_view(folded_.data() + entry.offset, entry.length).substr(0, folded.size()) == folded;
+    });
+
+    struct Range {
+        uint32_t best, begin, end;
+    };
+    auto worse = [this](const Range& a, const Range& b) { return ranksBefore(b.best, a.best); };
+    std::priority_queue<Range, std::vector<Range>, decltype(worse)> ranges(worse);
+    uint32_t begin = static_cast<uint32_t>(first - entries_.begin());
+    uint32_t end = static_cast<uint32_t>(last - entries_.begin());
+    if (begin < end) ranges.push({bestInRange(begin, end), begin, end});
+
+    while (!ranges.empty() && matches.size() < limit) {
+        Range range = ranges.top();
+        ranges.pop();
+
+        Node* node = entries_[range.best].node;
+        bool seen = std::any_of(matches.begin(), matches.end(), [node](const NameMatch& m) { return m.node == node; });
+        if (!seen) matches.push_back(makeMatch(range.best, 0));
+
+        if (range.begin < range.best) ranges.push({bestInRange(range.begin, range.best), range.begin, range.best});
+        if (range.best + 1 < range.end) ranges.push({bestInRange(range.best + 1, range.end), range.best + 1, range.end});
+    }
+    return matches;
+}
+
+/**
+ * @brief Walks the sorted keys as an implicit trie (a node is a range sharing a prefix)
+ *        with one Levenshtein row per depth, pruning ranges whose row minimum exceeds maxDistance.
+ */
+std::vector<NameMatch> AutocompleteIndex::fuzzy(std::string_view query, uint32_t maxDistance, size_t limit) const {
+    std::vector<NameMatch> matches;
+    if (entries_.empty() || limit == 0) return matches;
+
+    std::string folded = foldKey(query);
+    size_t width = folded.size() + 1;
+    // rows[d] = edit distance antara prefix key sepanjang d dan setiap prefix query
+    std::vector<uint32_t> rows((maxKeyLength_ + 1) * width);
+    for (size_t j = 0; j < width; ++j) rows[j] = static_cast<uint32_t>(j);
+
+    struct Frame {
+        uint32_t begin, end;
+        size_t depth;
+    };
+    std::vector<Frame> stack = {{0, static_cast<uint32_t>(entries_.size()), 0}};
+    std::vector<std::pair<uint32_t, uint32_t>> found;   // (distance, entry)
+
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        uint32_t* row = &rows[frame.depth * width];
+
+        if (frame.depth > 0) {
+            const uint32_t* above = row - width;
+            char c = key(frame.begin)[frame.depth - 1];
+            row[0] = static_cast<uint32_t>(frame.depth);
+            for (size_t j = 1; j < width; ++j) {
+                uint32_t substitute = above[j - 1] + (folded[j - 1] == c ? 0 : 1);
+                row[j] = std::min({above[j] + 1, row[j - 1] + 1, substitute});
+            }
+        }
+
+        // key yang panjangnya tepat depth ada di awal rentang
+        uint32_t i = frame.begin;
+        for (; i < frame.end && entries_[i].length == frame.depth; ++i) {
+            if (row[width - 1] <= maxDistance) found.push_back({row[width - 1], i});
+        }
+        if (*std::min_element(row, row + width) > maxDistance) continue;
+
+        while (i < frame.end) {
+            char c = key(i)[frame.depth];
+            auto next = std::partition_point(entries_.begin() + i, entries_.begin() + frame.end, [&](const Entry& entry) {
+                return folded_[entry.offset + frame.depth] == c;
+            });
+            uint32_t childEnd = static_cast<uint32_t>(next - entries_.begin());
+            stack.push_back({i, childEnd, frame.depth + 1});
+            i = childEnd;
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [this](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+        return a.first != b.first ? a.first < b.first : ranksBefore(a.second, b.second);
+    });
+    for (const auto& match : found) {
+        if (matches.size() >= limit) break;
+        Node* node = entries_[match.second].node;
+        bool seen = std::any_of(matches.begin(), matches.end(), [node](const NameMatch& m) { return m.node == node; });
+        if (!seen) matches.push_back(makeMatch(match.second, match.first));
+    }
+    return matches;
+}
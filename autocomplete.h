@@ -0,0 +1,56 @@
+#ifndef AUTOCOMPLETE_H
+#define AUTOCOMPLETE_H
+
+#include "tree.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct NameMatch {
+    Node* node;
+    std::string_view text;     // nama/common name asli yang cocok
+    uint32_t distance;         // edit distance ke query (0 untuk prefix match)
+};
+
+// Indeks semua nama taksonomi dan common name (lowercase), terurut seperti trie
+// yang diratakan: setiap prefix adalah satu rentang di array. Common name juga
+// diindeks mulai dari setiap katanya ("white shark", "shark" untuk "Great White Shark").
+// Indeks tidak mengikuti perubahan tree; panggil build() lagi setelah add/update/delete.
+class AutocompleteIndex {
+public:
+    void build(Node* root);
+    void clear();
+    size_t size() const { return entries_.size(); }
+
+    // Nama yang diawali prefix, paling banyak limit node berbeda. Urutan: key terpendek
+    // dulu (exact match selalu pertama), lalu nama taksonomi sebelum common name, lalu alfabetis.
+    std::vector<NameMatch> complete(std::string_view prefix, size_t limit) const;
+    // Nama dengan edit distance (Levenshtein) <= maxDistance ke query, urut berdasarkan
+    // distance lalu urutan yang sama dengan complete()
+    std::vector<NameMatch> fuzzy(std::string_view query, uint32_t maxDistance, size_t limit) const;
+
+private:
+    enum class KeyKind : uint8_t { Name, CommonName, CommonWord };
+
+    struct Entry {
+        uint32_t offset;       // posisi key di folded_
+        uint16_t length;
+        KeyKind kind;
+        Node* node;
+    };
+
+    std::string_view key(uint32_t index) const {
+        return std::string_view(folded_.data() + entries_[index].offset, entries_[index].length);
+    }
+    bool ranksBefore(uint32_t a, uint32_t b) const;
+    uint32_t bestInRange(uint32_t begin, uint32_t end) const;
+    NameMatch makeMatch(uint32_t index, uint32_t distance) const;
+
+    std::string folded_;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> best_;     // segment tree: index entry terbaik (ranksBefore) per rentang
+    size_t maxKeyLength_ = 0;
+};
+
+#endif
@@ -0,0 +1,641 @@
+#include "batch.h"
+#include "forest.h"
+#include "parallel.h"
+#include "query.h"
+#include "snapshot.h"
+#include "traversal.h"
+#include "wal.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// ukuran satu blok yang dibaca thread pembaca; baris yang lebih panjang membuat blok ikut membesar
+static const size_t READ_CHUNK_SIZE = 1 << 20;
+// blok yang sudah di-parse tapi belum diterapkan; membatasi memori saat pembaca lebih cepat
+static const size_t MAX_QUEUED_BLOCKS = 4;
+// grup read-only yang lebih kecil dari ini dijalankan langsung di thread pemanggil
+static const size_t PARALLEL_READ_GROUP = 256;
+static const size_t MAX_REPORTED_ERRORS = 5;
+
+enum class CommandKind : uint8_t { Add, Search, Update, Delete, Dump, Query };
+enum class DumpOrder : uint8_t { Tree, PreOrder, PostOrder, LevelOrder };
+
+struct BatchCommand {
+    CommandKind kind;
+    DumpOrder order;        // hanya untuk dump
+    uint32_t firstField;    // index ke CommandBlock::fields
+    uint32_t fieldCount;
+};
+
+// Sekumpulan baris lengkap beserta hasil parse-nya; fields menunjuk ke dalam text
+struct CommandBlock {
+    std::vector<char> text;
+    std::vector<std::string_view> fields;
+    std::vector<BatchCommand> commands;
+
+    std::string_view field(const BatchCommand& command, size_t i) const { return fields[command.firstField + i]; }
+};
+
+// Antrean blok dari thread pembaca ke thread yang menerapkan perintah
+class BlockQueue {
+public:
+    void push(std::unique_ptr<CommandBlock> block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] { return blocks_.size() < MAX_QUEUED_BLOCKS; });
+        blocks_.push_back(std::move(block));
+        notEmpty_.notify_one();
+    }
+
+    // nullptr jika pembaca sudah selesai dan antrean kosong
+    std::unique_ptr<CommandBlock> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [&] { return !blocks_.empty() || closed_; });
+        if (blocks_.empty()) return nullptr;
+        std::unique_ptr<CommandBlock> block = std::move(blocks_.front());
+        blocks_.pop_front();
+        notFull_.notify_one();
+        return block;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<std::unique_ptr<CommandBlock>> blocks_;
+    bool closed_ = false;
+};
+
+// --- PARSER (thread pembaca) ---
+
+/**
+ * @brief Applies one "key=value" query option to filter; false if the key or value is unknown.
+ */
+static bool parseQueryOption(std::string_view option, QueryFilter& filter) {
+    size_t equals = option.find('=');
+    if (equals == std::string_view::npos) return false;
+    std::string_view key = option.substr(0, equals), value = option.substr(equals + 1);
+
+    if (equalsFolded(key, "rank")) {
+        for (size_t i = 0; i < RANK_COUNT; ++i) {
+            if (equalsFolded(value, TAX_LEVELS[i])) {
+                filter.filterRank = true;
+                filter.rank = static_cast<Rank>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+    if (equalsFolded(key, "common")) {
+        filter.commonNamePattern.assign(value.data(), value.size());
+        return !value.empty();
+    }
+    if (equalsFolded(key, "wiki")) {
+        if (equalsFolded(value, "yes")) filter.wikiLink = QueryFilter::Link::Present;
+        else if (equalsFolded(value, "no")) filter.wikiLink = QueryFilter::Link::Missing;
+        else return false;
+        return true;
+    }
+    return false;
+}
+
+// statistik yang hanya diubah thread pembaca
+struct ReaderStats {
+    uint64_t bytes = 0;
+    size_t malformed = 0;
+    bool failed = false;
+};
+
+/**
+ * @brief Parses one non-empty line into block; returns an error text or nullptr on success.
+ */
+static const char* parseCommand(std::string_view line, CommandBlock& block) {
+    size_t wordEnd = std::min(line.find(' '), line.find('\t'));
+    std::string_view word = line.substr(0, wordEnd);
+    std::string_view rest;
+    if (wordEnd != std::string_view::npos) {
+        rest = line.substr(wordEnd);
+        size_t start = rest.find_first_not_of(" \t");
+        rest = start == std::string_view::npos ? std::string_view() : rest.substr(start);
+    }
+
+    BatchCommand command{CommandKind::Search, DumpOrder::Tree, static_cast<uint32_t>(block.fields.size()), 0};
+    if (equalsFolded(word, "add")) command.kind = CommandKind::Add;
+    else if (equalsFolded(word, "search")) command.kind = CommandKind::Search;
+    else if (equalsFolded(word, "update")) command.kind = CommandKind::Update;
+    else if (equalsFolded(word, "delete")) command.kind = CommandKind::Delete;
+    else if (equalsFolded(word, "dump")) command.kind = CommandKind::Dump;
+    else if (equalsFolded(word, "query")) command.kind = CommandKind::Query;
+    else return "unknown command";
+
+    // search/delete memakai sisa baris utuh sebagai nama; yang lain dipisah tab
+    std::vector<std::string_view> fields;
+    if (command.kind == CommandKind::Search || command.kind == CommandKind::Delete) {
+        if (!rest.empty()) fields.push_back(rest);
+    } else if (!rest.empty()) {
+        size_t pos = 0;
+        while (true) {
+            size_t tab = rest.find('\t', pos);
+            fields.push_back(rest.substr(pos, tab == std::string_view::npos ? std::string_view::npos : tab - pos));
+            if (tab == std::string_view::npos) break;
+            pos = tab + 1;
+        }
+    }
+
+    switch (command.kind) {
+        case CommandKind::Add:
+            if (fields.size() < REQUIRED_TOTAL_INPUTS || fields.size() > REQUIRED_TOTAL_INPUTS + 1) {
+                return "add expects Class..Species, common name and optional wiki link";
+            }
+            for (size_t i = 0; i < REQUIRED_TOTAL_INPUTS; ++i) {
+                if (fields[i].empty()) return "empty taxonomic or common name";
+            }
+            break;
+        case CommandKind::Search:
+        case CommandKind::Delete:
+            if (fields.empty()) return "missing name";
+            break;
+        case CommandKind::Update:
+            if (fields.size() < 2 || fields.size() > 3) return "update expects name, common name and optional wiki link";
+            if (fields[0].empty() || fields[1].empty()) return "empty name or common name";
+            break;
+        case CommandKind::Dump:
+            if (fields.size() > 1) return "dump expects at most one order";
+            if (fields.empty() || equalsFolded(fields[0], "tree")) command.order = DumpOrder::Tree;
+            else if (equalsFolded(fields[0], "preorder")) command.order = DumpOrder::PreOrder;
+            else if (equalsFolded(fields[0], "postorder")) command.order = DumpOrder::PostOrder;
+            else if (equalsFolded(fields[0], "levelorder")) command.order = DumpOrder::LevelOrder;
+            else return "unknown dump order";
+            break;
+        case CommandKind::Query: {
+            if (fields.empty() || fields[0].empty()) return "missing query pattern";
+            QueryFilter filter;
+            for (size_t i = 1; i < fields.size(); ++i) {
+                if (!parseQueryOption(fields[i], filter)) return "query options are rank=<Rank>, common=<glob>, wiki=yes|no";
+            }
+        } break;
+    }
+
+    command.fieldCount = static_cast<uint32_t>(fields.size());
+    block.fields.insert(block.fields.end(), fields.begin(), fields.end());
+    block.commands.push_back(command);
+    return nullptr;
+}
+
+/**
+ * @brief Reader thread: reads input in large chunks, cuts them at the last newline and parses
+ *        every complete line. The partial line at the end is carried over to the next block.
+ */
+static void readCommands(std::FILE* input, BlockQueue& queue, ReaderStats& stats) {
+    std::vector<char> carry;
+    size_t lineNumber = 0;
+    size_t reportedErrors = 0;
+
+    while (true) {
+        std::unique_ptr<CommandBlock> block(new CommandBlock());
+        std::vector<char>& text = block->text;
+        text.resize(carry.size() + READ_CHUNK_SIZE);
+        std::copy(carry.begin(), carry.end(), text.begin());
+        size_t got = std::fread(text.data() + carry.size(), 1, READ_CHUNK_SIZE, input);
+        stats.bytes += got;
+        bool eof = got < READ_CHUNK_SIZE;
+        if (eof && std::ferror(input)) stats.failed = true;
+        text.resize(carry.size() + got);
+
+        // hanya baris lengkap yang di-parse; text tidak diubah lagi setelah ini
+        size_t complete = text.size();
+        if (!eof) {
+            auto newline = std::find(text.rbegin(), text.rend(), '\n');
+            complete = static_cast<size_t>(text.rend() - newline);
+        }
+        carry.assign(text.begin() + complete, text.end());
+        text.resize(complete);
+
+        size_t pos = 0;
+        while (pos < complete) {
+            const char* begin = text.data() + pos;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', complete - pos));
+            size_t length = newline ? static_cast<size_t>(newline - begin) : complete - pos;
+            pos += length + 1;
+            ++lineNumber;
+
+            std::string_view line(begin, length);
+            if (lineNumber == 1 && line.substr(0, 3) == "\xEF\xBB\xBF") line.remove_prefix(3);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty() || line[0] == '#') continue;
+
+            if (const char* error = parseCommand(line, *block)) {
+                ++stats.malformed;
+                if (reportedErrors++ < MAX_REPORTED_ERRORS) {
+                    std::cerr << "[WARN] batch:" << lineNumber << ": " << error << ", command skipped.\n";
+                }
+            }
+        }
+
+        if (!block->commands.empty()) queue.push(std::move(block));
+        if (eof) break;
+    }
+    queue.close();
+}
+
+// --- EKSEKUSI ---
+
+static bool isReadOnly(CommandKind kind) {
+    return kind == CommandKind::Search || kind == CommandKind::Dump || kind == CommandKind::Query;
+}
+
+/**
+ * @brief Runs a search, query or dump; safe to call from several threads while nothing writes the tree.
+ */
+static void executeRead(Node* root, const CommandBlock& block, const BatchCommand& command,
+                        BufferedWriter& out, std::string& scratch) {
+    if (command.kind == CommandKind::Search) {
+        std::string_view name = block.field(command, 0);
+        scratch.assign(name.data(), name.size());
+        Node* found = searchNode(root, scratch);
+        if (found) {
+            out << "found ";
+            writeListingLine(out, found->rank, found->name.str(), nodeCommonName(found));
+        } else {
+            out << "not found: " << name << '\n';
+        }
+        return;
+    }
+
+    if (command.kind == CommandKind::Query) {
+        QueryFilter filter;
+        for (size_t i = 1; i < command.fieldCount; ++i) parseQueryOption(block.field(command, i), filter);
+        QueryCursor cursor = queryPath(root, block.field(command, 0), filter);
+        if (!cursor.error().empty()) {
+            out << "error: " << cursor.error() << '\n';
+            return;
+        }
+        size_t matches = 0;
+        for (Node* node : cursor) {
+            out << "match ";
+            writeListingLine(out, node->rank, node->name.str(), nodeCommonName(node));
+            ++matches;
+        }
+        out << "end query: " << matches << " matches\n";
+        return;
+    }
+
+    if (root == nullptr) return;
+    if (command.order == DumpOrder::Tree) {
+        TreeDisplaySink sink(out);
+        runTraversal(preOrder(root), sink);
+        return;
+    }
+    ListingSink sink(out);
+    switch (command.order) {
+        case DumpOrder::PreOrder:   runTraversal(preOrder(root), sink); break;
+        case DumpOrder::PostOrder:  runTraversal(postOrder(root), sink); break;
+        case DumpOrder::LevelOrder: runTraversal(levelOrder(root), sink); break;
+        case DumpOrder::Tree:       break;
+    }
+}
+
+/**
+ * @brief Runs commands [begin, end) of a read-only group. Large groups are split over the
+ *        pool; every task formats into its own buffer and the buffers are written in order.
+ */
+static void runReadGroup(Node* root, const CommandBlock& block, size_t begin, size_t end,
+                         BufferedWriter& out, ThreadPool& pool) {
+    size_t count = end - begin;
+    if (count < PARALLEL_READ_GROUP || pool.size() < 2) {
+        std::string scratch;
+        for (size_t i = begin; i < end; ++i) executeRead(root, block, block.commands[i], out, scratch);
+        return;
+    }
+
+    size_t tasks = std::min(pool.size() * 4, count / (PARALLEL_READ_GROUP / 2));
+    size_t perTask = (count + tasks - 1) / tasks;
+    std::vector<std::ostringstream> outputs(tasks);
+    {
+        TaskGroup group(pool);
+        for (size_t t = 0; t < tasks; ++t) {
+            group.run([&, t] {
+                BufferedWriter local(outputs[t]);
+                std::string scratch;
+                size_t first = begin + t * perTask, last = std::min(end, first + perTask);
+                for (size_t i = first; i < last; ++i) executeRead(root, block, block.commands[i], local, scratch);
+            });
+        }
+        group.wait();
+    }
+    for (std::ostringstream& output : outputs) {
+        out << output.str();
+    }
+}
+
+/**
+ * @brief Applies one add/update/delete and logs it when the tree actually changed.
+ * @return LSN of the log record, 0 if nothing was logged.
+ */
+static uint64_t executeWrite(Node*& root, const CommandBlock& block, const BatchCommand& command,
+                             BufferedWriter& out, OperationLog* log, BatchStats& stats) {
+    bool logging = log && log->isOpen();
+    uint64_t lsn = 0;
+
+    switch (command.kind) {
+        case CommandKind::Add: {
+            ++stats.adds;
+            std::vector<std::string_view> path(REQUIRED_TAX_LEVELS);
+            for (size_t i = 0; i < REQUIRED_TAX_LEVELS; ++i) path[i] = block.field(command, i);
+            std::string_view commonName = block.field(command, REQUIRED_TAX_LEVELS);
+            std::string_view wikiLink = command.fieldCount > REQUIRED_TOTAL_INPUTS ? block.field(command, REQUIRED_TOTAL_INPUTS) : std::string_view();
+
+            InsertResult result = insertSpeciesRecord(root, path, commonName, wikiLink);
+            if (logging && (result == InsertResult::Added || result == InsertResult::Updated)) {
+                lsn = log->logAdd(std::vector<std::string>(path.begin(), path.end()), std::string(commonName), std::string(wikiLink));
+            }
+            switch (result) {
+                case InsertResult::Added:     out << "added "; break;
+                case InsertResult::Updated:   out << "updated "; break;
+                case InsertResult::Unchanged: out << "unchanged "; break;
+                case InsertResult::Rejected:  out << "rejected "; break;
+            }
+            out << path[REQUIRED_TAX_LEVELS - 1] << '\n';
+        } break;
+        case CommandKind::Update: {
+            ++stats.updates;
+            std::string name(block.field(command, 0));
+            Node* species = searchNode(root, name);
+            if (species == nullptr) {
+                out << "not found: " << name << '\n';
+                break;
+            }
+            if (species->rank != Rank::Species) {
+                out << "not a species: " << name << '\n';
+                break;
+            }
+            // tanpa kolom wiki link, link yang lama dipertahankan
+            std::string commonName(block.field(command, 1));
+            std::string wikiLink = command.fieldCount > 2 ? std::string(block.field(command, 2)) : std::string(nodeWikiLink(species));
+            if (logging) lsn = log->logUpdate(nodePath(species), commonName, wikiLink);
+            updateSpeciesRecord(species, commonName, wikiLink);
+            out << "updated " << name << '\n';
+        } break;
+        case CommandKind::Delete: {
+            ++stats.deletes;
+            std::string name(block.field(command, 0));
+            size_t removed = deleteSpeciesRecord(root, name);
+            if (removed == 0) {
+                out << "not found: " << name << '\n';
+                break;
+            }
+            if (logging) lsn = log->logDelete(name);
+            out << "deleted " << removed << ": " << name << '\n';
+        } break;
+        case CommandKind::Search:
+        case CommandKind::Dump:
+        case CommandKind::Query:
+            break;
+    }
+    return lsn;
+}
+
+/**
+ * @brief Runs the consecutive deletes [begin, end) through one deleteSpeciesBatch, so every
+ *        affected children vector is compacted once. Output and log records are the same as
+ *        running the deletes one by one.
+ * @return LSN of the last log record, 0 if nothing was logged.
+ */
+static uint64_t executeDeleteRun(Node* root, const CommandBlock& block, size_t begin, size_t end,
+                                 BufferedWriter& out, OperationLog* log, BatchStats& stats) {
+    bool logging = log && log->isOpen();
+    uint64_t lsn = 0;
+    std::vector<std::string> names;
+    names.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) names.emplace_back(block.field(block.commands[i], 0));
+
+    std::vector<size_t> removed;
+    deleteSpeciesBatch(root, names, &removed);
+    stats.deletes += names.size();
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (removed[i] == 0) {
+            out << "not found: " << names[i] << '\n';
+            continue;
+        }
+        if (logging) lsn = log->logDelete(names[i]);
+        out << "deleted " << removed[i] << ": " << names[i] << '\n';
+    }
+    return lsn;
+}
+
+/**
+ * @brief Pipelined batch execution; see batch.h.
+ */
+bool runBatch(Node*& root, std::FILE* input, std::ostream& out, const BatchOptions& options, BatchStats* stats) {
+    BatchStats local;
+    BatchStats& result = stats ? *stats : local;
+    result = BatchStats();
+    auto started = std::chrono::steady_clock::now();
+
+    ThreadPool& pool = options.pool ? *options.pool : defaultThreadPool();
+    BlockQueue queue;
+    ReaderStats readerStats;
+    std::thread reader(readCommands, input, std::ref(queue), std::ref(readerStats));
+
+    bool logFailed = false;
+    bool logging = options.log && options.log->isOpen();
+    {
+        BufferedWriter writer(out);
+        // dengan log, hasil satu blok ditahan sampai perubahannya durable
+        std::ostringstream held;
+        BufferedWriter heldWriter(held);
+        BufferedWriter& blockOut = logging ? heldWriter : writer;
+        while (std::unique_ptr<CommandBlock> block = queue.pop()) {
+            // sesudah log gagal sisa input hanya dibaca habis supaya thread pembaca selesai
+            if (logFailed) continue;
+            const std::vector<BatchCommand>& commands = block->commands;
+            uint64_t lastLsn = 0;
+            size_t i = 0;
+            while (i < commands.size()) {
+                if (commands[i].kind == CommandKind::Delete) {
+                    size_t end = i + 1;
+                    while (end < commands.size() && commands[end].kind == CommandKind::Delete) ++end;
+                    if (end - i > 1) {
+                        uint64_t lsn = executeDeleteRun(root, *block, i, end, blockOut, options.log, result);
+                        if (lsn) lastLsn = lsn;
+                        i = end;
+                        continue;
+                    }
+                }
+                if (!isReadOnly(commands[i].kind)) {
+                    uint64_t lsn = executeWrite(root, *block, commands[i], blockOut, options.log, result);
+                    if (lsn) lastLsn = lsn;
+                    ++i;
+                    continue;
+                }
+
+                size_t end = i;
+                while (end < commands.size() && isReadOnly(commands[end].kind)) {
+                    if (commands[end].kind == CommandKind::Search) ++result.searches;
+                    else if (commands[end].kind == CommandKind::Query) ++result.queries;
+                    else ++result.dumps;
+                    ++end;
+                }
+                runReadGroup(root, *block, i, end, blockOut, pool);
+                i = end;
+            }
+            result.commands += commands.size();
+
+            // group commit: satu tunggu per blok, bukan per perintah
+            if (logging) {
+                heldWriter.flush();
+                if (!options.log->waitDurable(lastLsn)) {
+                    // hasil blok ini tidak pernah ditulis: perubahannya tidak durable
+                    logFailed = true;
+                    continue;
+                }
+                writer << held.str();
+                held.str(std::string());
+                if (options.log->needsCompaction()) {
+                    uint64_t checkpoint = options.log->lastLsn();
+                    options.log->compact(buildSnapshotImage(root, checkpoint), checkpoint, options.snapshotFile, true);
+                }
+            }
+        }
+    }
+    reader.join();
+
+    result.bytes = readerStats.bytes;
+    result.malformed = readerStats.malformed;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (logFailed) {
+        std::cerr << "[ERROR] The operation log could not be written; the remaining commands were not run.\n";
+        return false;
+    }
+    if (readerStats.failed) {
+        std::cerr << "[ERROR] Reading batch input failed; the commands read so far were applied.\n";
+        return false;
+    }
+    return true;
+}
+
+// --- FOREST ---
+
+/**
+ * @brief Runs one command against the forest with the same output lines as on a single tree.
+ */
+static void executeForestCommand(Forest& forest, const CommandBlock& block, const BatchCommand& command,
+                                 BufferedWriter& out, BatchStats& stats) {
+    switch (command.kind) {
+        case CommandKind::Add: {
+            ++stats.adds;
+            std::vector<std::string_view> path(REQUIRED_TAX_LEVELS);
+            for (size_t i = 0; i < REQUIRED_TAX_LEVELS; ++i) path[i] = block.field(command, i);
+            std::string_view wikiLink = command.fieldCount > REQUIRED_TOTAL_INPUTS ? block.field(command, REQUIRED_TOTAL_INPUTS) : std::string_view();
+            switch (forest.insert(path, block.field(command, REQUIRED_TAX_LEVELS), wikiLink)) {
+                case InsertResult::Added:     out << "added "; break;
+                case InsertResult::Updated:   out << "updated "; break;
+                case InsertResult::Unchanged: out << "unchanged "; break;
+                case InsertResult::Rejected:  out << "rejected "; break;
+            }
+            out << path[REQUIRED_TAX_LEVELS - 1] << '\n';
+        } break;
+        case CommandKind::Search: {
+            ++stats.searches;
+            std::string name(block.field(command, 0));
+            Node* found = forest.search(name);
+            if (found) {
+                out << "found ";
+                writeListingLine(out, found->rank, found->name.str(), nodeCommonName(found));
+            } else {
+                out << "not found: " << name << '\n';
+            }
+        } break;
+        case CommandKind::Update: {
+            ++stats.updates;
+            std::string name(block.field(command, 0));
+            Node* species = forest.search(name);
+            if (species == nullptr) {
+                out << "not found: " << name << '\n';
+                break;
+            }
+            if (species->rank != Rank::Species) {
+                out << "not a species: " << name << '\n';
+                break;
+            }
+            std::string wikiLink = command.fieldCount > 2 ? std::string(block.field(command, 2)) : std::string(nodeWikiLink(species));
+            forest.update(species, block.field(command, 1), wikiLink);
+            out << "updated " << name << '\n';
+        } break;
+        case CommandKind::Delete: {
+            ++stats.deletes;
+            std::string name(block.field(command, 0));
+            size_t removed = forest.remove(name);
+            if (removed == 0) out << "not found: " << name << '\n';
+            else out << "deleted " << removed << ": " << name << '\n';
+        } break;
+        case CommandKind::Query: {
+            ++stats.queries;
+            QueryFilter filter;
+            for (size_t i = 1; i < command.fieldCount; ++i) parseQueryOption(block.field(command, i), filter);
+            size_t matches = 0;
+            std::string error = queryForest(forest, block.field(command, 0), filter, [&](Node* node) {
+                out << "match ";
+                writeListingLine(out, node->rank, node->name.str(), nodeCommonName(node));
+                ++matches;
+            });
+            if (!error.empty()) out << "error: " << error << '\n';
+            else out << "end query: " << matches << " matches\n";
+        } break;
+        case CommandKind::Dump: {
+            // satu tree per shard, dalam urutan shard
+            ++stats.dumps;
+            std::string scratch;
+            for (uint32_t i = 0; i < forest.shardCount(); ++i) {
+                executeRead(forest.shard(i), block, command, out, scratch);
+            }
+        } break;
+    }
+}
+
+/**
+ * @brief Batch execution on a forest; see batch.h.
+ */
+bool runForestBatch(Forest& forest, std::FILE* input, std::ostream& out, BatchStats* stats) {
+    BatchStats local;
+    BatchStats& result = stats ? *stats : local;
+    result = BatchStats();
+    auto started = std::chrono::steady_clock::now();
+
+    BlockQueue queue;
+    ReaderStats readerStats;
+    std::thread reader(readCommands, input, std::ref(queue), std::ref(readerStats));
+    {
+        BufferedWriter writer(out);
+        while (std::unique_ptr<CommandBlock> block = queue.pop()) {
+            for (const BatchCommand& command : block->commands) {
+                executeForestCommand(forest, *block, command, writer, result);
+            }
+            result.commands += block->commands.size();
+        }
+    }
+    reader.join();
+
+    result.bytes = readerStats.bytes;
+    result.malformed = readerStats.malformed;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (readerStats.failed) {
+        std::cerr << "[ERROR] Reading batch input failed; the commands read so far were applied.\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "tree.h"
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+class Forest;
+class OperationLog;
+class ThreadPool;
+
+// --- BATCH COMMAND MODE ---
+// Satu perintah per baris; kata perintah dipisah spasi/tab dari argumennya, argumen
+// dipisah tab (nama boleh mengandung spasi). Baris kosong dan baris '#' dilewati.
+//   add     Class<TAB>Order<TAB>Family<TAB>Genus<TAB>Species<TAB>CommonName[<TAB>WikiLink]
+//   search  name
+//   update  name<TAB>CommonName[<TAB>WikiLink]
+//   delete  name
+//   dump    [tree|preorder|postorder|levelorder]
+//   query   pattern[<TAB>rank=Genus][<TAB>common=*White*][<TAB>wiki=yes|no]   (pola: lihat query.h)
+// Hasil setiap perintah ditulis berurutan ke satu BufferedWriter:
+//   added|updated|unchanged|rejected <species>, found <Rank>: <name> [<common>],
+//   not found: <name>, not a species: <name>, deleted <n>: <name>, lalu isi dump;
+//   query menulis "match <Rank>: <name> [<common>]" per hasil lalu "end query: <n> matches".
+// Dengan operation log, perintah dibaca per blok dan hasil satu blok baru ditulis sesudah
+// semua perubahannya di-fsync (group commit), jadi "added/updated/deleted" yang sudah terlihat
+// di output pasti bisa dipulihkan setelah crash. Jika log gagal ditulis, hasil blok itu dibuang,
+// sisa perintah tidak dijalankan, dan runBatch mengembalikan false.
+
+struct BatchOptions {
+    OperationLog* log = nullptr;        // jika terbuka, setiap perubahan dicatat (group commit per blok)
+    std::string snapshotFile;           // tujuan checkpoint saat log perlu dipadatkan
+    ThreadPool* pool = nullptr;         // untuk grup perintah read-only; nullptr = defaultThreadPool()
+};
+
+// ringkasan satu kali batch
+struct BatchStats {
+    size_t commands = 0;
+    size_t adds = 0;
+    size_t searches = 0;
+    size_t updates = 0;
+    size_t deletes = 0;
+    size_t dumps = 0;
+    size_t queries = 0;
+    size_t malformed = 0;
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+};
+
+// Membaca perintah dari input (file atau stdin) di thread pembaca sementara tree
+// menerapkannya di thread pemanggil. Perintah read-only yang berurutan dijalankan
+// bersama (paralel bila grupnya cukup besar), delete yang berurutan sebagai satu
+// deleteSpeciesBatch (output sama dengan satu per satu). false jika input gagal dibaca.
+bool runBatch(Node*& root, std::FILE* input, std::ostream& out, const BatchOptions& options, BatchStats* stats = nullptr);
+// Perintah dan output yang sama, tetapi ke Forest (Class berbeda diterima): search dan delete
+// memakai indeks nama global, query memakai queryForest, dump menulis setiap shard berurutan.
+// Forest tidak punya operation log; perintah dijalankan berurutan di thread pemanggil.
+bool runForestBatch(Forest& forest, std::FILE* input, std::ostream& out, BatchStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,765 @@
+// Benchmark suite: kernel nama case-insensitive dan operasi tree di atas taksonomi sintetis.
+// Build:     g++ -std=c++17 -O2 -pthread [-mavx2] -o bench bench.cpp tree.cpp traversal.cpp fold.cpp metrics.cpp frozen.cpp lca.cpp parallel.cpp forest.cpp query.cpp exporter.cpp diff.cpp concurrent.cpp wal.cpp snapshot.cpp
+//            (Windows/MinGW: tambahkan -lpsapi)
+// Jalankan:  ./bench [--nodes N] [--fanout O,F,G] [--seed S] [--queries Q] [--json FILE|-] [--no-kernel]
+//   --nodes    jumlah node target, 10^3 .. 10^7 (default 100000)
+//   --fanout   rata-rata anak per Order, Family, Genus (default 6,8,12); jumlah Order menyesuaikan --nodes
+//   --seed     seed generator, hasil tree sama untuk seed dan opsi yang sama (default 42)
+//   --queries  jumlah operasi untuk search/update/delete (default 200000)
+//   --json     tulis hasil sebagai JSON ke FILE ("-" = stdout), satu hasil per baris agar mudah di-diff
+#include "tree.h"
+#include "traversal.h"
+#include "fold.h"
+#include "frozen.h"
+#include "lca.h"
+#include "concurrent.h"
+#include "parallel.h"
+#include "forest.h"
+#include "exporter.h"
+#include "diff.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+// --- ALOKASI & MEMORI ---
+
+// dihitung oleh operator new global di bawah; atomic karena kasus lca/forest memakai thread pool
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> allocatedBytes{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+// GCC >= 11 salah mengira pasangan new/free di sini tidak cocok setelah di-inline
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/**
+ * @brief Peak resident set size of the process so far, in KiB.
+ */
+static long peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<long>(usage.ru_maxrss / 1024);   // macOS: byte
+#else
+    return static_cast<long>(usage.ru_maxrss);          // Linux: KiB
+#endif
+#endif
+}
+
+// --- PENGUKURAN ---
+
+struct Result {
+    std::string name;
+    uint64_t operations;
+    double seconds;
+    uint64_t allocations;
+    uint64_t bytes;
+    long peakRssKb;
+};
+
+static std::vector<Result> results;
+
+// mencegah compiler membuang hasil yang tidak dipakai
+static volatile uint64_t sink;
+
+// Mengumpulkan waktu dan alokasi dari beberapa potongan kode yang diukur
+class Stopwatch {
+public:
+    void start() {
+        allocations_ -= allocationCount;
+        bytes_ -= allocatedBytes;
+        started_ = Clock::now();
+    }
+    void stop() {
+        elapsed_ += Clock::now() - started_;
+        allocations_ += allocationCount;
+        bytes_ += allocatedBytes;
+    }
+    void record(const char* name, uint64_t operations) const {
+        results.push_back({name, operations, std::chrono::duration<double>(elapsed_).count(),
+                           allocations_, bytes_, peakRssKb()});
+    }
+
+private:
+    Clock::time_point started_;
+    Clock::duration elapsed_{0};
+    uint64_t allocations_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+template <typename Body>
+static void run(const char* name, uint64_t operations, Body body) {
+    Stopwatch watch;
+    watch.start();
+    uint64_t result = body();
+    watch.stop();
+    sink = sink + result;
+    watch.record(name, operations);
+}
+
+// Membuang semua output std::cout selama scope (format tetap dikerjakan, hanya tidak ditulis)
+class MutedCout {
+public:
+    MutedCout() : previous_(std::cout.rdbuf(&discard_)) {}
+    ~MutedCout() { std::cout.rdbuf(previous_); }
+
+private:
+    struct DiscardBuffer : std::streambuf {
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+    DiscardBuffer discard_;
+    std::streambuf* previous_;
+};
+
+// --- GENERATOR TAKSONOMI ---
+
+// Bentuk tree disimpan sebagai index parent per rank; nama dibentuk ulang dari index,
+// jadi 10^7 node tidak perlu menyimpan 10^7 string di luar tree.
+struct Taxonomy {
+    std::vector<uint32_t> familyOrder;    // family -> order
+    std::vector<uint32_t> genusFamily;    // genus -> family
+    std::vector<uint32_t> speciesGenus;   // species -> genus
+    size_t orders = 0;
+    size_t nodes = 0;                     // termasuk root Class
+};
+
+class NameGenerator {
+public:
+    explicit NameGenerator(uint32_t seed) {
+        static const char* const BASE[32] = {
+            "ca", "ra", "lo", "mi", "ne", "tu", "sa", "pe", "ri", "do", "ga", "le", "mo", "ni", "pa", "ro",
+            "se", "ti", "va", "ze", "ba", "ce", "di", "fa", "go", "hi", "ko", "lu", "ma", "no", "po", "qu",
+        };
+        std::copy(BASE, BASE + 32, syllables_);
+        std::mt19937 rng(seed);
+        for (size_t i = 31; i > 0; --i) std::swap(syllables_[i], syllables_[rng() % (i + 1)]);
+    }
+
+    void order(std::string& out, uint64_t index) const { stem(out, index, true); out += "iformes"; }
+    void family(std::string& out, uint64_t index) const { stem(out, index, true); out += "idae"; }
+    void genus(std::string& out, uint64_t index) const { stem(out, index, true); out += "odon"; }
+    // "Genus epithet"; index di luar tree menghasilkan nama valid yang tidak ada (untuk miss)
+    void species(std::string& out, uint64_t genusIndex, uint64_t index) const {
+        genus(out, genusIndex);
+        out += ' ';
+        appendStem(out, index);
+        out += "us";
+    }
+    void commonName(std::string& out, uint64_t index) const { stem(out, index, true); out += " shark"; }
+
+private:
+    void stem(std::string& out, uint64_t index, bool capital) const {
+        out.clear();
+        appendStem(out, index);
+        if (capital) out[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(out[0])));
+    }
+    // bijective base-32 dengan suku kata 2 huruf, jadi setiap index punya stem unik
+    void appendStem(std::string& out, uint64_t index) const {
+        for (uint64_t n = index + 1; n > 0; n = (n - 1) / 32) out += syllables_[(n - 1) % 32];
+    }
+
+    const char* syllables_[32];
+};
+
+/**
+ * @brief Draws a fan-out uniformly from [1, 2*mean-1], so the average stays at mean.
+ */
+static uint32_t drawFanout(std::mt19937_64& rng, uint32_t mean) {
+    return mean <= 1 ? 1 : 1 + static_cast<uint32_t>(rng() % (2 * mean - 1));
+}
+
+/**
+ * @brief Generates a Class -> Order -> Family -> Genus -> Species shape with about targetNodes nodes.
+ *        Ancestors are only created together with their first species, so every leaf is a Species
+ *        (as with addSpeciesPath); Orders keep being added until the target is met.
+ */
+static Taxonomy generateTaxonomy(size_t targetNodes, const uint32_t fanout[3], std::mt19937_64& rng) {
+    Taxonomy tax;
+    tax.nodes = 1;
+    while (true) {
+        bool orderMade = false;
+        for (uint32_t f = drawFanout(rng, fanout[0]); f > 0; --f) {
+            bool familyMade = false;
+            for (uint32_t g = drawFanout(rng, fanout[1]); g > 0; --g) {
+                bool genusMade = false;
+                for (uint32_t s = drawFanout(rng, fanout[2]); s > 0; --s) {
+                    if (tax.nodes >= targetNodes) return tax;
+                    if (!orderMade) {
+                        ++tax.orders;
+                        ++tax.nodes;
+                        orderMade = true;
+                    }
+                    if (!familyMade) {
+                        tax.familyOrder.push_back(static_cast<uint32_t>(tax.orders - 1));
+                        ++tax.nodes;
+                        familyMade = true;
+                    }
+                    if (!genusMade) {
+                        tax.genusFamily.push_back(static_cast<uint32_t>(tax.familyOrder.size() - 1));
+                        ++tax.nodes;
+                        genusMade = true;
+                    }
+                    tax.speciesGenus.push_back(static_cast<uint32_t>(tax.genusFamily.size() - 1));
+                    ++tax.nodes;
+                }
+            }
+        }
+    }
+}
+
+// Menyusun path addSpeciesPath untuk satu species; string di path dipakai ulang antar panggilan
+static void speciesPath(const Taxonomy& tax, const NameGenerator& names, size_t species,
+                        std::vector<std::string>& path, std::string& commonName, std::string& wikiLink) {
+    uint32_t genus = tax.speciesGenus[species];
+    uint32_t family = tax.genusFamily[genus];
+    path[0] = "Chondrichthyes";
+    names.order(path[1], tax.familyOrder[family]);
+    names.family(path[2], family);
+    names.genus(path[3], genus);
+    names.species(path[4], genus, species);
+    names.commonName(commonName, species);
+    wikiLink = "https://en.wikipedia.org/wiki/";
+    wikiLink += path[4];
+    std::replace(wikiLink.begin(), wikiLink.end(), ' ', '_');
+}
+
+// --- OUTPUT ---
+
+static void printTable(std::FILE* out) {
+    std::fprintf(out, "%-36s %12s %12s %12s %12s %12s\n", "benchmark", "ops", "ns/op", "allocs/op", "bytes/op", "peak KiB");
+    for (const Result& r : results) {
+        double ops = static_cast<double>(r.operations);
+        std::fprintf(out, "%-36s %12llu %12.1f %12.2f %12.1f %12ld\n", r.name.c_str(),
+                     static_cast<unsigned long long>(r.operations), r.seconds * 1e9 / ops,
+                     static_cast<double>(r.allocations) / ops, static_cast<double>(r.bytes) / ops, r.peakRssKb);
+    }
+}
+
+static void writeJson(std::FILE* out, uint32_t seed, const Taxonomy& tax, const uint32_t fanout[3], size_t queries) {
+#if defined(__clang__) || defined(__GNUC__)
+    const char* compiler = __VERSION__;
+#elif defined(_MSC_VER)
+    const char* compiler = "msvc";
+#else
+    const char* compiler = "unknown";
+#endif
+    std::fprintf(out, "{\n  \"meta\": {\"seed\": %u, \"nodes\": %zu, \"species\": %zu, \"fanout\": [%u, %u, %u], "
+                      "\"queries\": %zu, \"fold_kernel\": \"%s\", \"compiler\": \"%s\", \"peak_rss_kb\": %ld},\n",
+                 seed, tax.nodes, tax.speciesGenus.size(), fanout[0], fanout[1], fanout[2], queries,
+                 foldKernelName(), compiler, peakRssKb());
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        double ops = static_cast<double>(r.operations);
+        std::fprintf(out, "    {\"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.1f, \"allocs_per_op\": %.3f, "
+                          "\"bytes_per_op\": %.1f, \"peak_rss_kb\": %ld}%s\n",
+                     r.name.c_str(), static_cast<unsigned long long>(r.operations), r.seconds * 1e9 / ops,
+                     static_cast<double>(r.allocations) / ops, static_cast<double>(r.bytes) / ops, r.peakRssKb,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+// --- BENCHMARK ---
+
+// toLower versi lama (salinan per panggilan, std::tolower per karakter) sebagai pembanding
+static std::string toLowerCopy(const std::string& str) {
+    std::string data = str;
+    std::transform(data.begin(), data.end(), data.begin(), [](unsigned char c) { return std::tolower(c); });
+    return data;
+}
+
+static void benchKernel(std::mt19937_64& rng, size_t queries) {
+    std::vector<std::string> names, mixed;
+    for (size_t i = 0; i < 100000; ++i) {
+        std::string name = "Carcharhiniformes" + std::to_string(rng() % 100000);
+        std::string query = name;
+        for (char& c : query) {
+            if (rng() % 2) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        names.push_back(name);
+        mixed.push_back(query);
+    }
+    size_t rounds = std::max<size_t>(1, queries * 10 / names.size()), ops = rounds * names.size();
+
+    run("kernel/equality via toLower (old)", ops, [&] {
+        uint64_t equal = 0;
+        for (size_t r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < names.size(); ++i) equal += toLowerCopy(names[i]) == toLowerCopy(mixed[i]);
+        return equal;
+    });
+    run("kernel/equalsFolded", ops, [&] {
+        uint64_t equal = 0;
+        for (size_t r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < names.size(); ++i) equal += equalsFolded(names[i], mixed[i]);
+        return equal;
+    });
+    run("kernel/hash via toLower (old)", ops, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r)
+            for (const std::string& query : mixed) total += std::hash<std::string>()(toLowerCopy(query));
+        return total;
+    });
+    run("kernel/hashFolded", ops, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r)
+            for (const std::string& query : mixed) total += hashFolded(query);
+        return total;
+    });
+}
+
+/**
+ * @brief Builds the tree through addSpeciesPath in batches, timing only the calls themselves.
+ */
+static Node* benchAdd(const Taxonomy& tax, const NameGenerator& names, bool record = true) {
+    const size_t BATCH = 1024;
+    std::vector<std::vector<std::string>> paths(BATCH, std::vector<std::string>(REQUIRED_TAX_LEVELS));
+    std::vector<std::string> commonNames(BATCH), wikiLinks(BATCH);
+
+    // root dibuat terpisah; addSpeciesPath hanya menambah di bawah root yang sudah ada
+    Node* root = createNode(new TreeContext, "Chondrichthyes", Rank::Class);
+    Stopwatch watch;
+    MutedCout muted;
+    size_t total = tax.speciesGenus.size();
+    for (size_t first = 0; first < total; first += BATCH) {
+        size_t count = std::min(BATCH, total - first);
+        for (size_t i = 0; i < count; ++i) speciesPath(tax, names, first + i, paths[i], commonNames[i], wikiLinks[i]);
+        watch.start();
+        for (size_t i = 0; i < count; ++i) root = addSpeciesPath(root, paths[i], commonNames[i], wikiLinks[i]);
+        watch.stop();
+    }
+    if (record) watch.record("tree/addSpeciesPath", total);
+    return root;
+}
+
+/**
+ * @brief Builds the same taxonomy as a forest (one shard, then one shard per Order) through
+ *        insertAll in import-sized chunks, and searches it through the global name index.
+ */
+static void benchForest(const Taxonomy& tax, const NameGenerator& names, const std::vector<std::string>& hits) {
+    const size_t CHUNK = 65536;
+    size_t total = tax.speciesGenus.size();
+    std::vector<std::vector<std::string>> paths(std::min(CHUNK, total), std::vector<std::string>(REQUIRED_TAX_LEVELS));
+    std::vector<std::string> commonNames(paths.size()), wikiLinks(paths.size());
+    std::vector<SpeciesRecord> records(paths.size());
+
+    for (Rank shardBy : {Rank::Class, Rank::Order}) {
+        Forest forest(shardBy);
+        Stopwatch watch;
+        for (size_t first = 0; first < total; first += CHUNK) {
+            size_t count = std::min(CHUNK, total - first);
+            records.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                speciesPath(tax, names, first + i, paths[i], commonNames[i], wikiLinks[i]);
+                for (size_t level = 0; level < REQUIRED_TAX_LEVELS; ++level) records[i].path[level] = paths[i][level];
+                records[i].commonName = commonNames[i];
+                records[i].wikiLink = wikiLinks[i];
+            }
+            watch.start();
+            forest.insertAll(records);
+            watch.stop();
+        }
+        watch.record(shardBy == Rank::Class ? "forest/insertAll (1 Class shard)" : "forest/insertAll (Order shards)", total);
+
+        if (shardBy == Rank::Order) {
+            run("forest/search hit (species)", hits.size(), [&] {
+                uint64_t found = 0;
+                for (const std::string& query : hits) found += forest.search(query) != nullptr;
+                return found;
+            });
+        }
+    }
+}
+
+/**
+ * @brief Concurrent mode: cost of publishing a version after a batch of updates, and search
+ *        latency of a reader on the latest version with and without a writer publishing.
+ *        The allocation counters are process-wide, so the reader case "during updates" also
+ *        counts the writer's allocations.
+ */
+static void benchConcurrent(const Taxonomy& tax, const NameGenerator& names, const std::vector<std::string>& hits) {
+    const size_t BATCH = 64;
+    size_t species = tax.speciesGenus.size();
+    ConcurrentTree tree(benchAdd(tax, names, false));
+
+    // batch update common name yang sudah disiapkan; setiap putaran memakai nama yang berbeda
+    std::vector<std::string> path(REQUIRED_TAX_LEVELS);
+    std::string commonName, wikiLink;
+    std::vector<std::vector<LogRecord>> batches(std::max<size_t>(1, std::min<size_t>(hits.size() / BATCH, 1000)));
+    for (size_t b = 0; b < batches.size(); ++b) {
+        for (size_t i = 0; i < BATCH; ++i) {
+            speciesPath(tax, names, ((b * BATCH + i) * 7919) % species, path, commonName, wikiLink);
+            batches[b].push_back(LogRecord{0, LogOp::Update, path, "concurrent " + std::to_string(b), wikiLink, ""});
+        }
+    }
+
+    run("concurrent/publish (64 updates per version)", batches.size() * BATCH, [&] {
+        for (const std::vector<LogRecord>& batch : batches) tree.apply(batch);
+        return uint64_t(tree.currentVersion());
+    });
+
+    auto searchAll = [&] {
+        uint64_t found = 0;
+        for (const std::string& query : hits) {
+            ConcurrentTree::ReadGuard guard = tree.read();
+            found += guard->search(query) != nullptr;
+        }
+        return found;
+    };
+    run("concurrent/search hit (no writer)", hits.size(), searchAll);
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> published{0};
+    std::thread writer([&] {
+        for (size_t b = 0; !stop.load(std::memory_order_relaxed); b = (b + 1) % batches.size()) {
+            tree.apply(batches[b]);
+            published.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    run("concurrent/search hit (during updates)", hits.size(), searchAll);
+    stop.store(true);
+    writer.join();
+    std::fprintf(stderr, "concurrent: %llu versions published while searching, %zu retired versions pending\n",
+                 static_cast<unsigned long long>(published.load()), tree.retiredCount());
+}
+
+static void benchTree(const Taxonomy& tax, const NameGenerator& names, std::mt19937_64& rng, size_t queries) {
+    Node* root = benchAdd(tax, names);
+    size_t species = tax.speciesGenus.size();
+
+    // query disiapkan di luar pengukuran; huruf besar/kecil diacak seperti input pengguna
+    std::vector<std::string> path(REQUIRED_TAX_LEVELS), hits, misses, commonHits;
+    std::string commonName, wikiLink;
+    std::vector<size_t> picks(queries);
+    for (size_t& pick : picks) pick = rng() % species;
+    for (size_t pick : picks) {
+        speciesPath(tax, names, pick, path, commonName, wikiLink);
+        for (char& c : path[4]) {
+            if (rng() % 4 == 0) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        hits.push_back(path[4]);
+        commonHits.push_back(commonName);
+        std::string miss;
+        names.species(miss, tax.speciesGenus[pick], species + pick);   // epithet di luar tree
+        misses.push_back(std::move(miss));
+    }
+
+    run("tree/searchNode hit (species)", queries, [&] {
+        uint64_t found = 0;
+        for (const std::string& query : hits) found += searchNode(root, query) != nullptr;
+        return found;
+    });
+    run("tree/searchNode hit (common name)", queries, [&] {
+        uint64_t found = 0;
+        for (const std::string& query : commonHits) found += searchNode(root, query) != nullptr;
+        return found;
+    });
+    run("tree/searchNode miss", queries, [&] {
+        uint64_t found = 0;
+        for (const std::string& query : misses) found += searchNode(root, query) != nullptr;
+        return found;
+    });
+
+    // --- TRAVERSAL --- (diulang sampai kira-kira sebanyak queries node)
+    size_t nodes = tax.nodes, rounds = std::max<size_t>(1, queries / nodes), visits = rounds * nodes;
+    run("traversal/preOrder iterator", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) { CountingSink counter; runTraversal(preOrder(root), counter); total += counter.total; }
+        return total;
+    });
+    run("traversal/postOrder iterator", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) { CountingSink counter; runTraversal(postOrder(root), counter); total += counter.total; }
+        return total;
+    });
+    run("traversal/levelOrder iterator", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) { CountingSink counter; runTraversal(levelOrder(root), counter); total += counter.total; }
+        return total;
+    });
+    // --- PARALEL --- sama dengan kasus sekuensial di atas/bawahnya, dibagi per subtree di defaultThreadPool
+    run("parallel/forEachNode", visits, [&] {
+        std::atomic<uint64_t> total{0};
+        for (size_t r = 0; r < rounds; ++r) parallelForEachNode(root, [&total](Node*) { total.fetch_add(1, std::memory_order_relaxed); });
+        return total.load();
+    });
+    auto linkedSpecies = [](const Node* node) { return node->rank == Rank::Species && !nodeWikiLink(node).empty(); };
+    run("traversal/findAll (linked species)", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            std::vector<Node*> found;
+            for (const TraversalEntry& entry : preOrder(root)) {
+                if (linkedSpecies(entry.node)) found.push_back(entry.node);
+            }
+            total += found.size();
+        }
+        return total;
+    });
+    run("parallel/findAll (linked species)", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) total += parallelFindAll(root, linkedSpecies).size();
+        return total;
+    });
+    run("parallel/speciesCountPerOrder", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const auto& entry : speciesCountPerOrder(root)) total += entry.second;
+        }
+        return total;
+    });
+    {
+        MutedCout muted;
+        run("traversal/preOrderTraversal", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) preOrderTraversal(root);
+            return uint64_t(0);
+        });
+        run("traversal/postOrderTraversal", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) postOrderTraversal(root);
+            return uint64_t(0);
+        });
+        run("traversal/levelOrderTraversal", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) levelOrderTraversal(root);
+            return uint64_t(0);
+        });
+        run("traversal/displayTree", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) displayTree(root);
+            return uint64_t(0);
+        });
+        run("export/JSON Lines", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) exportTree(root, ExportFormat::JsonLines, std::cout);
+            return uint64_t(0);
+        });
+        run("export/Newick", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) exportTree(root, ExportFormat::Newick, std::cout);
+            return uint64_t(0);
+        });
+    }
+
+    // --- FROZEN TREE ---
+    FrozenTree frozen;
+    run("frozen/rebuild", nodes, [&] {
+        frozen.rebuild(root);
+        return uint64_t(frozen.size());
+    });
+    run("frozen/preOrder scan", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            size_t perRank[RANK_COUNT] = {};
+            for (uint32_t i = 0; i < frozen.size(); ++i) ++perRank[static_cast<size_t>(frozen.rank(i))];
+            for (size_t count : perRank) total += count;
+        }
+        return total;
+    });
+    run("frozen/levelOrder scan", visits, [&] {
+        uint64_t total = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            size_t perRank[RANK_COUNT] = {};
+            for (uint32_t index : frozen.levelOrder()) ++perRank[static_cast<size_t>(frozen.rank(index))];
+            for (size_t count : perRank) total += count;
+        }
+        return total;
+    });
+    run("frozen/search hit (species)", queries, [&] {
+        uint64_t found = 0;
+        for (const std::string& query : hits) found += frozen.search(query) != FrozenTree::NONE;
+        return found;
+    });
+
+    // pasangan species acak, nama dicari di dalam pengukuran seperti pemakaian sebenarnya
+    std::vector<std::pair<std::string, std::string>> pairs(queries);
+    for (size_t i = 0; i < queries; ++i) pairs[i] = {hits[i], hits[(i * 7919 + 1) % queries]};
+    LcaIndex lca;
+    run("lca/index rebuild", nodes, [&] {
+        lca.rebuild(frozen);
+        return uint64_t(frozen.size());
+    });
+    run("lca/lowestCommonAncestor (indexes)", queries, [&] {
+        uint64_t total = 0;
+        for (size_t i = 0; i < queries; ++i) total += lca.lowestCommonAncestor(static_cast<uint32_t>(picks[i] % nodes), static_cast<uint32_t>((picks[i] * 31) % nodes));
+        return total;
+    });
+    run("lca/sharedAncestors (name pairs)", queries, [&] {
+        uint64_t total = 0;
+        for (const SharedAncestor& result : sharedAncestors(lca, pairs)) total += result.distance;
+        return total;
+    });
+    {
+        MutedCout muted;
+        run("frozen/preOrderTraversal", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) preOrderTraversal(frozen);
+            return uint64_t(0);
+        });
+        run("frozen/levelOrderTraversal", visits, [&] {
+            for (size_t r = 0; r < rounds; ++r) levelOrderTraversal(frozen);
+            return uint64_t(0);
+        });
+    }
+
+    benchForest(tax, names, hits);
+    benchConcurrent(tax, names, hits);
+
+    // --- DIFF --- salinan tree dengan sebagian kecil species diubah
+    {
+        Node* copy = benchAdd(tax, names, false);
+        size_t changes = std::max<size_t>(1, species / 1000);
+        MutedCout muted;
+        for (size_t i = 0; i < changes; ++i) {
+            speciesPath(tax, names, i * (species / changes), path, commonName, wikiLink);
+            updateSpeciesRecord(searchNode(copy, path[4]), "changed " + std::to_string(i), "");
+        }
+        run("diff/identical trees", 1, [&] {
+            return uint64_t(diffTrees(root, root, [](const DiffEntry&) {}).visited);
+        });
+        run("diff/0.1% species changed (per change)", changes, [&] {
+            return uint64_t(diffTrees(root, copy, [](const DiffEntry&) {}).changed);
+        });
+        deleteTree(copy);
+    }
+
+    // --- UPDATE & DELETE ---
+    std::vector<Node*> targets;
+    std::vector<std::string> newCommonNames;
+    for (size_t i = 0; i < queries; ++i) {
+        targets.push_back(searchNode(root, hits[i]));
+        newCommonNames.push_back("Updated shark " + std::to_string(i));
+    }
+    std::string newLink = "https://en.wikipedia.org/wiki/Shark";
+    {
+        MutedCout muted;
+        run("tree/updateSpecies", queries, [&] {
+            uint64_t updated = 0;
+            for (size_t i = 0; i < queries; ++i) updated += updateSpecies(targets[i], newCommonNames[i], newLink);
+            return updated;
+        });
+    }
+
+    // species yang berbeda, paling banyak setengah tree supaya tree tidak habis
+    std::vector<size_t> order(species);
+    for (size_t i = 0; i < species; ++i) order[i] = i;
+    size_t deletes = std::min(queries, std::max<size_t>(1, species / 2));
+    for (size_t i = 0; i < deletes; ++i) std::swap(order[i], order[i + rng() % (species - i)]);
+    std::vector<std::string> doomed;
+    for (size_t i = 0; i < deletes; ++i) {
+        speciesPath(tax, names, order[i], path, commonName, wikiLink);
+        doomed.push_back(path[4]);
+    }
+    {
+        MutedCout muted;
+        run("tree/deleteSpecies", deletes, [&] {
+            for (const std::string& name : doomed) root = deleteSpecies(root, name);
+            return uint64_t(root != nullptr);
+        });
+    }
+
+    CountingSink remaining;
+    runTraversal(preOrder(root), remaining);
+    run("tree/deleteTree", remaining.total, [&] {
+        deleteTree(root);
+        return uint64_t(1);
+    });
+}
+
+/**
+ * @brief Parses "a,b,c" into three positive fan-out means.
+ */
+static bool parseFanout(const char* text, uint32_t fanout[3]) {
+    unsigned a = 0, b = 0, c = 0;
+    if (std::sscanf(text, "%u,%u,%u", &a, &b, &c) != 3 || a == 0 || b == 0 || c == 0) return false;
+    fanout[0] = a;
+    fanout[1] = b;
+    fanout[2] = c;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    size_t targetNodes = 100000, queries = 200000;
+    uint32_t seed = 42;
+    uint32_t fanout[3] = {6, 8, 12};
+    const char* jsonPath = nullptr;
+    bool kernel = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--nodes" && hasValue) {
+            targetNodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--fanout" && hasValue) {
+            if (!parseFanout(argv[++i], fanout)) {
+                std::cerr << "Error: --fanout expects three positive numbers, e.g. 6,8,12.\n";
+                return 1;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--queries" && hasValue) {
+            queries = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--no-kernel") {
+            kernel = false;
+        } else {
+            std::cerr << "Usage: bench [--nodes N] [--fanout O,F,G] [--seed S] [--queries Q] [--json FILE|-] [--no-kernel]\n";
+            return 1;
+        }
+    }
+    if (targetNodes < 5 || queries == 0) {
+        std::cerr << "Error: --nodes must be at least 5 and --queries at least 1.\n";
+        return 1;
+    }
+
+    std::mt19937_64 rng(seed);
+    NameGenerator names(seed);
+    Taxonomy tax = generateTaxonomy(targetNodes, fanout, rng);
+    std::fprintf(stderr, "fold kernel: %s, %zu nodes (%zu orders, %zu families, %zu genera, %zu species)\n",
+                 foldKernelName(), tax.nodes, tax.orders, tax.familyOrder.size(), tax.genusFamily.size(),
+                 tax.speciesGenus.size());
+
+    if (kernel) benchKernel(rng, queries);
+    benchTree(tax, names, rng, queries);
+
+    if (jsonPath == nullptr) {
+        printTable(stdout);
+        return 0;
+    }
+    std::FILE* out = std::strcmp(jsonPath, "-") == 0 ? stdout : std::fopen(jsonPath, "w");
+    if (out == nullptr) {
+        std::cerr << "Error: Could not open '" << jsonPath << "' for writing.\n";
+        return 1;
+    }
+    writeJson(out, seed, tax, fanout, queries);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,371 @@
+#include "concurrent.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+// --- INDEKS NAMA PERSISTENT ---
+// Radix dua level atas hashFolded(nama): 8 bit teratas memilih page, 8 bit berikutnya
+// bucket. Writer menyalin page & bucket yang diubah (path copying); page dan bucket yang
+// dibuat untuk versi yang sedang disusun (version sama) boleh diubah langsung.
+
+static const unsigned NAME_PAGE_BITS = 8;
+static const unsigned NAME_BUCKET_BITS = 8;
+static const size_t NAME_PAGES = size_t(1) << NAME_PAGE_BITS;
+static const size_t NAME_BUCKETS = size_t(1) << NAME_BUCKET_BITS;
+
+struct VersionNameEntry {
+    uint64_t hash;
+    std::shared_ptr<const VersionPath> path;
+};
+
+struct VersionNameBucket {
+    uint64_t version = 0;
+    std::vector<VersionNameEntry> entries;
+};
+
+struct VersionNamePage {
+    uint64_t version = 0;
+    std::vector<std::shared_ptr<VersionNameBucket>> buckets = std::vector<std::shared_ptr<VersionNameBucket>>(NAME_BUCKETS);
+};
+
+struct VersionNameTable {
+    uint64_t version = 0;
+    std::vector<std::shared_ptr<VersionNamePage>> pages = std::vector<std::shared_ptr<VersionNamePage>>(NAME_PAGES);
+};
+
+static size_t pageOf(uint64_t hash) {
+    return static_cast<size_t>(hash >> (64 - NAME_PAGE_BITS));
+}
+
+static size_t bucketOf(uint64_t hash) {
+    return static_cast<size_t>((hash >> (64 - NAME_PAGE_BITS - NAME_BUCKET_BITS)) & (NAME_BUCKETS - 1));
+}
+
+// --- VERSI (reader) ---
+
+const VersionNode* VersionNode::child(std::string_view name, uint32_t* position) const {
+    uint64_t hash = hashFolded(name);
+    auto it = std::lower_bound(childByName.begin(), childByName.end(), std::make_pair(hash, uint32_t(0)));
+    for (; it != childByName.end() && it->first == hash; ++it) {
+        const VersionNode* candidate = children[it->second].get();
+        if (equalsFolded(candidate->name(), name)) {
+            if (position) *position = it->second;
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+const VersionNode* TreeVersion::findPath(const std::vector<std::string>& path) const {
+    const VersionNode* node = root.get();
+    if (node == nullptr || path.empty() || !equalsFolded(node->name(), path[0])) return nullptr;
+    for (size_t level = 1; level < path.size() && node; ++level) {
+        node = node->child(path[level]);
+    }
+    return node;
+}
+
+/**
+ * @brief Looks up the index entries of the name and resolves each one from the root. The
+ *        child positions on the way form the pre-order key, so the smallest key wins.
+ */
+const VersionNode* TreeVersion::search(std::string_view name) const {
+    if (!root || !names) return nullptr;
+    uint64_t hash = hashFolded(name);
+    const VersionNamePage* page = names->pages[pageOf(hash)].get();
+    const VersionNameBucket* bucket = page ? page->buckets[bucketOf(hash)].get() : nullptr;
+    if (bucket == nullptr) return nullptr;
+
+    const VersionNode* best = nullptr;
+    uint32_t bestKey[RANK_COUNT] = {};
+    size_t bestDepth = 0;
+    for (const VersionNameEntry& entry : bucket->entries) {
+        if (entry.hash != hash) continue;
+
+        // nama dari Class sampai node itu
+        std::string_view chain[RANK_COUNT];
+        size_t depth = 0;
+        for (const VersionPath* link = entry.path.get(); link && depth < RANK_COUNT; link = link->parent.get()) {
+            chain[depth++] = link->name;
+        }
+        std::reverse(chain, chain + depth);
+        if (depth == 0 || !equalsFolded(root->name(), chain[0])) continue;
+
+        const VersionNode* node = root.get();
+        uint32_t key[RANK_COUNT] = {};
+        for (size_t level = 1; level < depth && node; ++level) {
+            node = node->child(chain[level], &key[level]);
+        }
+        if (node == nullptr || (!equalsFolded(node->name(), name) && !equalsFolded(node->commonName, name))) continue;
+
+        // ancestor punya key yang merupakan prefix, jadi lebih kecil: sama dengan urutan pre-order
+        if (best == nullptr || std::lexicographical_compare(key, key + depth, bestKey, bestKey + bestDepth)) {
+            best = node;
+            std::copy(key, key + depth, bestKey);
+            bestDepth = depth;
+        }
+    }
+    return best;
+}
+
+// --- PENYUSUN VERSI (writer) ---
+
+namespace {
+
+// Menyusun satu versi baru dari versi sebelumnya dan tree writer
+class VersionBuilder {
+public:
+    VersionBuilder(uint64_t number, const std::shared_ptr<const VersionNameTable>& previous) : number_(number) {
+        names_ = previous ? std::make_shared<VersionNameTable>(*previous) : std::make_shared<VersionNameTable>();
+        names_->version = number;
+    }
+
+    /**
+     * @brief Returns the version of node given its previous version old. Subtrees with an
+     *        unchanged contentHash are shared as they are; changed nodes are copied and
+     *        their children synced in the order of the writer's tree.
+     */
+    std::shared_ptr<const VersionNode> sync(const std::shared_ptr<const VersionNode>& old, const Node* node,
+                                            const std::shared_ptr<const VersionPath>& parentPath) {
+        if (node == nullptr) {
+            if (old) drop(*old);
+            return nullptr;
+        }
+        if (!old || old->name() != node->name.str() || old->rank != node->rank) {
+            if (old) drop(*old);
+            return build(node, parentPath);
+        }
+        if (old->contentHash == contentHash(node)) return old;
+
+        auto copy = std::make_shared<VersionNode>();
+        copy->path = old->path;
+        copy->rank = old->rank;
+        copy->commonName = nodeCommonName(node);
+        copy->wikiLink = nodeWikiLink(node);
+        copy->speciesCount = static_cast<uint32_t>(speciesCount(node));
+        copy->contentHash = contentHash(node);
+        if (copy->commonName != old->commonName) {
+            unindexCommonName(*old);
+            indexCommonName(*copy);
+        }
+
+        std::vector<bool> paired(old->children.size(), false);
+        copy->children.reserve(node->children.size());
+        for (const Node* child : node->children) {
+            uint32_t position = 0;
+            std::shared_ptr<const VersionNode> previous;
+            if (old->child(child->name.str(), &position) && !paired[position]) {
+                paired[position] = true;
+                previous = old->children[position];
+            }
+            copy->children.push_back(sync(previous, child, copy->path));
+        }
+        for (size_t i = 0; i < paired.size(); ++i) {
+            if (!paired[i]) drop(*old->children[i]);
+        }
+        indexChildren(*copy);
+        return copy;
+    }
+
+    std::shared_ptr<const VersionNameTable> names() const { return names_; }
+
+private:
+    // subtree baru seluruhnya
+    std::shared_ptr<const VersionNode> build(const Node* node, const std::shared_ptr<const VersionPath>& parentPath) {
+        auto path = std::make_shared<VersionPath>();
+        path->parent = parentPath;
+        path->name = node->name.str();
+
+        auto copy = std::make_shared<VersionNode>();
+        copy->path = path;
+        copy->rank = node->rank;
+        copy->commonName = nodeCommonName(node);
+        copy->wikiLink = nodeWikiLink(node);
+        copy->speciesCount = static_cast<uint32_t>(speciesCount(node));
+        copy->contentHash = contentHash(node);
+        addName(hashFolded(copy->name()), copy->path);
+        indexCommonName(*copy);
+
+        copy->children.reserve(node->children.size());
+        for (const Node* child : node->children) {
+            copy->children.push_back(build(child, copy->path));
+        }
+        indexChildren(*copy);
+        return copy;
+    }
+
+    // subtree yang tidak ada lagi di versi baru: entri indeks namanya dibuang
+    void drop(const VersionNode& node) {
+        removeName(hashFolded(node.name()), node.path.get());
+        unindexCommonName(node);
+        for (const auto& child : node.children) drop(*child);
+    }
+
+    static void indexChildren(VersionNode& node) {
+        node.childByName.resize(node.children.size());
+        for (uint32_t i = 0; i < node.children.size(); ++i) {
+            node.childByName[i] = {hashFolded(node.children[i]->name()), i};
+        }
+        std::sort(node.childByName.begin(), node.childByName.end());
+    }
+
+    // common name didaftarkan seperti di name index tree: hanya jika berbeda dengan nama taksonomi
+    static bool hasOwnCommonName(const VersionNode& node) {
+        return !node.commonName.empty() && !equalsFolded(node.commonName, node.name());
+    }
+
+    void indexCommonName(const VersionNode& node) {
+        if (hasOwnCommonName(node)) addName(hashFolded(node.commonName), node.path);
+    }
+
+    void unindexCommonName(const VersionNode& node) {
+        if (hasOwnCommonName(node)) removeName(hashFolded(node.commonName), node.path.get());
+    }
+
+    // bucket yang boleh diubah: disalin dulu jika masih milik versi yang sudah dipublikasikan
+    VersionNameBucket& writableBucket(uint64_t hash) {
+        std::shared_ptr<VersionNamePage>& page = names_->pages[pageOf(hash)];
+        if (!page) {
+            page = std::make_shared<VersionNamePage>();
+            page->version = number_;
+        } else if (page->version != number_) {
+            page = std::make_shared<VersionNamePage>(*page);
+            page->version = number_;
+        }
+        std::shared_ptr<VersionNameBucket>& bucket = page->buckets[bucketOf(hash)];
+        if (!bucket) {
+            bucket = std::make_shared<VersionNameBucket>();
+            bucket->version = number_;
+        } else if (bucket->version != number_) {
+            bucket = std::make_shared<VersionNameBucket>(*bucket);
+            bucket->version = number_;
+        }
+        return *bucket;
+    }
+
+    void addName(uint64_t hash, const std::shared_ptr<const VersionPath>& path) {
+        writableBucket(hash).entries.push_back({hash, path});
+    }
+
+    void removeName(uint64_t hash, const VersionPath* path) {
+        std::vector<VersionNameEntry>& entries = writableBucket(hash).entries;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].hash == hash && entries[i].path.get() == path) {
+                entries[i] = std::move(entries.back());
+                entries.pop_back();
+                return;
+            }
+        }
+    }
+
+    uint64_t number_;
+    std::shared_ptr<VersionNameTable> names_;
+};
+
+}  // namespace
+
+// --- CONCURRENT TREE ---
+
+ConcurrentTree::ConcurrentTree(Node* root) : root_(root) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    publish();
+}
+
+ConcurrentTree::~ConcurrentTree() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    for (const Retired& retired : retired_) {
+        delete retired.version;
+    }
+    retired_.clear();
+    delete current_.load();
+    deleteTree(root_);
+}
+
+// --- READER ---
+
+/**
+ * @brief Claims a reader slot with the current epoch, then loads the current version.
+ *        Only fails to finish in a bounded number of steps when more than MAX_READERS
+ *        guards are alive at the same time.
+ */
+ConcurrentTree::ReadGuard ConcurrentTree::read() const {
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS;
+    for (size_t i = start;; i = (i + 1) % MAX_READERS) {
+        std::atomic<uint64_t>& slot = slots_[i].epoch;
+        uint64_t expected = 0;
+        if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, epoch_.load() + 1)) {
+            // slot sudah terlihat oleh writer sebelum pointer versi dibaca
+            return ReadGuard(&slot, current_.load());
+        }
+    }
+}
+
+ConcurrentTree::ReadGuard::~ReadGuard() {
+    if (slot_) slot_->store(0, std::memory_order_release);
+}
+
+// --- WRITER ---
+
+uint64_t ConcurrentTree::apply(const std::vector<LogRecord>& batch) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    for (const LogRecord& record : batch) {
+        applyLogRecord(root_, record);
+    }
+    publish();
+    return nextVersion_ - 1;
+}
+
+uint64_t ConcurrentTree::currentVersion() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return nextVersion_ - 1;
+}
+
+size_t ConcurrentTree::retiredCount() const {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return retired_.size();
+}
+
+/**
+ * @brief Builds the next version from the current one by path copying and swaps it in;
+ *        the previous version is retired with the epoch it was replaced in. Caller holds
+ *        writeMutex_. Only the writer touches reference counts, so readers stay wait-free.
+ */
+void ConcurrentTree::publish() {
+    TreeVersion* previous = current_.load();
+    TreeVersion* version = new TreeVersion();
+    version->number = nextVersion_++;
+
+    VersionBuilder builder(version->number, previous ? previous->names : nullptr);
+    version->root = builder.sync(previous ? previous->root : nullptr, root_, nullptr);
+    version->names = builder.names();
+
+    current_.store(version);
+    uint64_t epoch = epoch_.fetch_add(1);
+    if (previous) retired_.push_back({previous, epoch});
+    reclaim();
+}
+
+/**
+ * @brief Frees retired versions that no active reader can still reference:
+ *        a reader holding one entered at an epoch <= the epoch it was retired in.
+ *        Nodes still shared with newer versions stay alive through their reference count.
+ */
+void ConcurrentTree::reclaim() {
+    if (retired_.empty()) return;
+
+    uint64_t oldestReader = UINT64_MAX;
+    for (const ReaderSlot& slot : slots_) {
+        uint64_t value = slot.epoch.load();
+        if (value != 0 && value - 1 < oldestReader) oldestReader = value - 1;
+    }
+
+    size_t kept = 0;
+    for (const Retired& retired : retired_) {
+        if (retired.epoch < oldestReader) {
+            delete retired.version;
+        } else {
+            retired_[kept++] = retired;
+        }
+    }
+    retired_.resize(kept);
+}
@@ -0,0 +1,126 @@
+#ifndef CONCURRENT_H
+#define CONCURRENT_H
+
+#include "tree.h"
+#include "wal.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Mode konkuren: reader membaca versi tree yang immutable tanpa lock, writer mengubah
+// tree miliknya sendiri lalu mempublikasikan versi baru dengan path copying. Hanya node
+// yang contentHash-nya berubah (node yang diubah dan ancestor-nya) yang disalin; subtree
+// lain dipakai bersama dengan versi sebelumnya lewat shared_ptr. Indeks nama setiap versi
+// juga persistent, jadi biaya satu publish sebanding dengan jumlah perubahan, bukan ukuran tree.
+// TreeVersion lama baru dilepas setelah tidak ada reader yang mungkin masih memakainya
+// (epoch-based reclamation); node yang hanya dimiliki versi itu ikut di-free saat itu.
+
+// Nama node beserta rantai ancestor-nya; dipakai bersama oleh semua salinan node yang sama,
+// sehingga entri indeks nama tetap berlaku walaupun ancestor-nya disalin
+struct VersionPath {
+    std::shared_ptr<const VersionPath> parent;
+    std::string name;
+};
+
+// Satu node versi; tidak pernah diubah setelah dipublikasikan
+struct VersionNode {
+    std::shared_ptr<const VersionPath> path;
+    Rank rank = Rank::Class;
+    std::string commonName;
+    std::string wikiLink;
+    uint32_t speciesCount = 0;      // species di subtree ini
+    uint64_t contentHash = 0;       // contentHash() node asal saat versi dibuat
+    std::vector<std::shared_ptr<const VersionNode>> children;   // urutan sama dengan tree
+    std::vector<std::pair<uint64_t, uint32_t>> childByName;      // (hashFolded nama, index anak), urut
+
+    std::string_view name() const { return path->name; }
+    // Anak dengan nama itu (case-insensitive), nullptr jika tidak ada; position = index anak
+    const VersionNode* child(std::string_view name, uint32_t* position = nullptr) const;
+};
+
+struct VersionNameTable;   // indeks nama persistent (concurrent.cpp)
+
+// Satu versi tree yang sudah dipublikasikan
+struct TreeVersion {
+    uint64_t number = 0;
+    std::shared_ptr<const VersionNode> root;
+    std::shared_ptr<const VersionNameTable> names;
+
+    // Sama seperti searchNode: nama taksonomi atau common name, case-insensitive,
+    // node pertama dalam pre-order versi ini jika ada beberapa. nullptr jika tidak ada.
+    const VersionNode* search(std::string_view name) const;
+    // Mengikuti path dari Class ke bawah, nullptr jika putus
+    const VersionNode* findPath(const std::vector<std::string>& path) const;
+    size_t speciesCount() const { return root ? root->speciesCount : 0; }
+};
+
+class ConcurrentTree {
+public:
+    // jumlah reader aktif sekaligus yang dijamin wait-free
+    static const size_t MAX_READERS = 128;
+
+    // Mengambil alih root (boleh nullptr); versi pertama langsung dipublikasikan
+    explicit ConcurrentTree(Node* root);
+    ConcurrentTree(const ConcurrentTree&) = delete;
+    ConcurrentTree& operator=(const ConcurrentTree&) = delete;
+    // Semua ReadGuard harus sudah dilepas
+    ~ConcurrentTree();
+
+    // Pegangan reader atas satu versi; versi itu tetap hidup sampai guard dilepas
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : slot_(other.slot_), version_(other.version_) { other.slot_ = nullptr; }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ~ReadGuard();
+
+        const TreeVersion& version() const { return *version_; }
+        const TreeVersion* operator->() const { return version_; }
+        uint64_t number() const { return version_->number; }
+
+    private:
+        friend class ConcurrentTree;
+        ReadGuard(std::atomic<uint64_t>* slot, const TreeVersion* version) : slot_(slot), version_(version) {}
+
+        std::atomic<uint64_t>* slot_;
+        const TreeVersion* version_;
+    };
+
+    // Reader: tidak pernah menunggu writer
+    ReadGuard read() const;
+
+    // Writer: semua record diterapkan lalu dipublikasikan sebagai satu versi baru.
+    // Mengembalikan nomor versi yang baru. Writer lain menunggu (mutex writer).
+    uint64_t apply(const std::vector<LogRecord>& batch);
+    uint64_t currentVersion() const;
+    // Versi lama yang belum bisa di-free karena masih mungkin dibaca
+    size_t retiredCount() const;
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};   // 0 = kosong, selain itu epoch saat masuk + 1
+    };
+    struct Retired {
+        TreeVersion* version;
+        uint64_t epoch;
+    };
+
+    void publish();
+    void reclaim();
+
+    mutable ReaderSlot slots_[MAX_READERS];
+    std::atomic<TreeVersion*> current_{nullptr};
+    std::atomic<uint64_t> epoch_{1};
+
+    mutable std::mutex writeMutex_;       // melindungi root_, retired_, nextVersion_
+    Node* root_;
+    std::vector<Retired> retired_;
+    uint64_t nextVersion_ = 1;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include "diff.h"
+#include "exporter.h"
+#include "traversal.h"
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+class TreeDiff {
+public:
+    explicit TreeDiff(const std::function<void(const DiffEntry&)>& visit) : visit_(visit) {}
+
+    /**
+     * @brief Compares two nodes with the same name. Equal content hashes mean equal
+     *        subtrees, so only pairs whose hashes differ are descended into.
+     */
+    void compare(const Node* before, const Node* after) {
+        if (contentHash(before) == contentHash(after)) return;
+        ++stats.visited;
+
+        if (nodeCommonName(before) != nodeCommonName(after) || nodeWikiLink(before) != nodeWikiLink(after)) {
+            ++stats.changed;
+            visit_(DiffEntry{DiffKind::Changed, before, after});
+        }
+
+        // tree yang dibangun dari data yang sama biasanya punya urutan anak yang sama,
+        // jadi posisi yang sama dicoba dulu sebelum lookup lewat childIndex. Anak after yang
+        // sudah berpasangan ditandai: tree buatan tangan boleh punya nama anak kembar, dan
+        // setiap anak after hanya boleh dipasangkan sekali.
+        const auto& afterChildren = after->children;
+        std::vector<bool> paired(afterChildren.size(), false);
+        size_t unpaired = afterChildren.size();
+        std::unordered_map<const Node*, size_t> position;   // dibangun hanya jika urutan anak berbeda
+        auto positionOf = [&](const Node* node) {
+            if (position.empty()) {
+                for (size_t k = 0; k < afterChildren.size(); ++k) position.emplace(afterChildren[k], k);
+            }
+            return position.find(node)->second;
+        };
+        for (size_t i = 0; i < before->children.size(); ++i) {
+            const Node* child = before->children[i];
+            size_t match = afterChildren.size();
+            if (i < afterChildren.size() && !paired[i] && equalsFolded(afterChildren[i]->name.str(), child->name.str())) {
+                match = i;
+            } else if (const Node* found = after->childIndex.find(afterChildren, child->name.str())) {
+                match = positionOf(found);
+                // anak pertama dengan nama itu sudah dipakai: cari kembarannya yang belum
+                for (size_t k = 0; k < afterChildren.size() && paired[match]; ++k) {
+                    if (!paired[k] && equalsFolded(afterChildren[k]->name.str(), child->name.str())) match = k;
+                }
+                if (paired[match]) match = afterChildren.size();
+            }
+            if (match < afterChildren.size()) {
+                paired[match] = true;
+                --unpaired;
+                compare(child, afterChildren[match]);
+            } else {
+                emitSubtree(child, DiffKind::Removed);
+            }
+        }
+        if (unpaired == 0) return;
+        for (size_t k = 0; k < afterChildren.size(); ++k) {
+            if (!paired[k]) emitSubtree(afterChildren[k], DiffKind::Added);
+        }
+    }
+
+    // semua species di subtree yang hanya ada di satu sisi
+    void emitSubtree(const Node* root, DiffKind kind) {
+        std::vector<const Node*> stack{root};
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            if (node->rank == Rank::Species) {
+                if (kind == DiffKind::Added) {
+                    ++stats.added;
+                    visit_(DiffEntry{kind, nullptr, node});
+                } else {
+                    ++stats.removed;
+                    visit_(DiffEntry{kind, node, nullptr});
+                }
+            }
+            for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) stack.push_back(*it);
+        }
+    }
+
+    DiffStats stats;
+
+private:
+    const std::function<void(const DiffEntry&)>& visit_;
+};
+
+} // namespace
+
+DiffStats diffTrees(const Node* before, const Node* after, const std::function<void(const DiffEntry&)>& visit) {
+    TreeDiff diff(visit);
+    if (before && after && equalsFolded(before->name.str(), after->name.str())) {
+        diff.compare(before, after);
+    } else {
+        if (before) diff.emitSubtree(before, DiffKind::Removed);
+        if (after) diff.emitSubtree(after, DiffKind::Added);
+    }
+    return diff.stats;
+}
+
+// --- OUTPUT ---
+
+static void writeMetadata(BufferedWriter& out, const Node* node) {
+    out << "\"commonName\":";
+    appendJsonString(out, nodeCommonName(node));
+    out << ",\"wikiLink\":";
+    appendJsonString(out, nodeWikiLink(node));
+}
+
+void writeDiffEntry(BufferedWriter& out, const DiffEntry& entry) {
+    static const char* const KIND_NAMES[] = {"added", "removed", "changed"};
+    const Node* node = entry.after ? entry.after : entry.before;
+
+    // path dari root tree node itu; rank sama dengan kedalaman, jadi paling banyak RANK_COUNT
+    const Node* path[RANK_COUNT];
+    size_t depth = 0;
+    for (const Node* n = node; n != nullptr && depth < RANK_COUNT; n = n->parent) path[depth++] = n;
+
+    out << "{\"change\":\"" << KIND_NAMES[static_cast<size_t>(entry.kind)] << "\",\"path\":[";
+    for (size_t i = depth; i-- > 0;) {
+        appendJsonString(out, path[i]->name.str());
+        if (i > 0) out << ',';
+    }
+    out << "],";
+    if (entry.kind == DiffKind::Changed) {
+        out << "\"before\":{";
+        writeMetadata(out, entry.before);
+        out << "},\"after\":{";
+        writeMetadata(out, entry.after);
+        out << '}';
+    } else {
+        writeMetadata(out, node);
+    }
+    out << "}\n";
+}
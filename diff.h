@@ -0,0 +1,47 @@
+#ifndef DIFF_H
+#define DIFF_H
+
+#include "tree.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class BufferedWriter;
+
+// --- DIFF DUA TREE ---
+// Berjalan di kedua tree bersamaan, anak dipasangkan berdasarkan nama (case-insensitive);
+// setiap anak dipasangkan paling banyak sekali, jadi nama anak kembar (tree buatan tangan)
+// yang tidak kebagian pasangan dilaporkan sebagai Removed/Added.
+// Pasangan dengan contentHash sama dilewati tanpa turun ke anak-anaknya, jadi biaya diff
+// sebanding dengan jumlah path yang berubah, bukan ukuran tree. Subtree yang hanya ada di
+// satu sisi dilaporkan per species (Removed/Added); node yang ada di kedua sisi dengan
+// common name atau wiki link berbeda dilaporkan sebagai Changed.
+enum class DiffKind : uint8_t {
+    Added,
+    Removed,
+    Changed
+};
+
+struct DiffEntry {
+    DiffKind kind;
+    const Node* before;     // nullptr untuk Added
+    const Node* after;      // nullptr untuk Removed
+};
+
+struct DiffStats {
+    size_t added = 0;
+    size_t removed = 0;
+    size_t changed = 0;
+    size_t visited = 0;     // pasangan node yang dibandingkan (yang dilewati lewat hash tidak dihitung)
+};
+
+// before/after boleh nullptr (tree kosong). Root dengan nama berbeda berarti semua species
+// dihapus lalu ditambahkan. visit dipanggil dalam urutan children tree before, lalu yang baru.
+DiffStats diffTrees(const Node* before, const Node* after, const std::function<void(const DiffEntry&)>& visit);
+
+// Satu baris JSON per entry:
+//   {"change":"added","path":["Chondrichthyes",...,"carcharias"],"commonName":"...","wikiLink":"..."}
+//   {"change":"changed","path":[...],"before":{"commonName":...,"wikiLink":...},"after":{...}}
+void writeDiffEntry(BufferedWriter& out, const DiffEntry& entry);
+
+#endif
@@ -0,0 +1,160 @@
+#include "exporter.h"
+#include "traversal.h"
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+ExportFormat exportFormatFor(const std::string& filename) {
+    size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos) return ExportFormat::JsonLines;
+    std::string extension = toLower(filename.substr(dot + 1));
+    if (extension == "nwk" || extension == "newick" || extension == "tre") return ExportFormat::Newick;
+    return ExportFormat::JsonLines;
+}
+
+/**
+ * @brief Writes text as a quoted JSON string. Runs of plain bytes go out in one write;
+ *        bytes >= 0x80 are passed through, so UTF-8 stays UTF-8.
+ */
+void appendJsonString(BufferedWriter& out, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    out << '"';
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.write(text.substr(start, i - start));
+        start = i + 1;
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default: {
+                char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                out.write(std::string_view(escaped, sizeof(escaped)));
+            }
+        }
+    }
+    out.write(text.substr(start));
+    out << '"';
+}
+
+// --- JSON LINES ---
+
+static void writeJsonNode(BufferedWriter& out, const Node* node, const Node* exportRoot) {
+    out << "{\"id\":" << node->id << ",\"parent\":";
+    if (node == exportRoot) {
+        out << "null";
+    } else {
+        out << node->parent->id;
+    }
+    out << ",\"rank\":";
+    appendJsonString(out, rankName(node->rank));
+    out << ",\"name\":";
+    appendJsonString(out, node->name.str());
+
+    std::string_view commonName = nodeCommonName(node);
+    std::string_view wikiLink = nodeWikiLink(node);
+    if (!commonName.empty()) {
+        out << ",\"commonName\":";
+        appendJsonString(out, commonName);
+    }
+    if (!wikiLink.empty()) {
+        out << ",\"wikiLink\":";
+        appendJsonString(out, wikiLink);
+    }
+    out << "}\n";
+}
+
+static void exportJsonLines(const Node* root, BufferedWriter& out) {
+    std::vector<const Node*> stack{root};
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+        writeJsonNode(out, node, root);
+        // dibalik supaya anak pertama keluar lebih dulu
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) stack.push_back(*it);
+    }
+}
+
+// --- NEWICK ---
+
+static void writeNewickLabel(BufferedWriter& out, std::string_view label) {
+    if (label.find_first_of(" \t()[]':;,") == std::string_view::npos) {
+        out.write(label);
+        return;
+    }
+    out << '\'';
+    size_t start = 0;
+    for (size_t quote = label.find('\''); quote != std::string_view::npos; quote = label.find('\'', start)) {
+        out.write(label.substr(start, quote + 1 - start)) << '\'';
+        start = quote + 1;
+    }
+    out.write(label.substr(start)) << '\'';
+}
+
+/**
+ * @brief Iterative post-order: "(" when a node with children is entered, "," between
+ *        siblings, and ")" plus the label once the last child is done.
+ */
+static void exportNewick(const Node* root, BufferedWriter& out) {
+    struct Frame {
+        const Node* node;
+        size_t nextChild;
+    };
+    std::vector<Frame> stack{{root, 0}};
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        const Node* node = frame.node;
+        if (frame.nextChild < node->children.size()) {
+            out << (frame.nextChild == 0 ? '(' : ',');
+            stack.push_back({node->children[frame.nextChild++], 0});
+            continue;
+        }
+        if (!node->children.empty()) out << ')';
+        writeNewickLabel(out, node->name.str());
+        stack.pop_back();
+    }
+    out << ";\n";
+}
+
+void exportTree(const Node* root, ExportFormat format, BufferedWriter& out) {
+    if (root == nullptr) {
+        if (format == ExportFormat::Newick) out << ";\n";
+        return;
+    }
+    if (format == ExportFormat::Newick) {
+        exportNewick(root, out);
+    } else {
+        exportJsonLines(root, out);
+    }
+}
+
+void exportTree(const Node* root, ExportFormat format, std::ostream& out) {
+    BufferedWriter writer(out);
+    exportTree(root, format, writer);
+}
+
+bool exportTreeFile(const Node* root, ExportFormat format, const std::string& filename) {
+    if (filename == "-") {
+        exportTree(root, format, std::cout);
+        std::cout.flush();
+        return static_cast<bool>(std::cout);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[ERROR] Cannot open '" << filename << "' for export.\n";
+        return false;
+    }
+    exportTree(root, format, file);
+    file.flush();
+    if (!file) {
+        std::cerr << "[ERROR] Failed to write export to '" << filename << "'.\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include "tree.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class BufferedWriter;
+
+// --- EXPORT ---
+// Menulis tree dalam satu pass pre-order lewat BufferedWriter (buffer berukuran tetap),
+// jadi memori tambahan hanya sebanding dengan kedalaman tree, bukan jumlah node.
+//
+// JsonLines: satu objek JSON per baris, parent selalu muncul sebelum anaknya:
+//   {"id":3,"parent":1,"rank":"Family","name":"Lamnidae"}
+//   {"id":5,"parent":4,"rank":"Species","name":"carcharias","commonName":"Great White Shark","wikiLink":"..."}
+// id adalah id node di tree ini (tidak stabil antar proses); parent null untuk root export.
+// Newick: satu baris "((carcharias)Carcharodon)...Chondrichthyes;" dengan nama sebagai label;
+// label yang memuat spasi atau tanda baca Newick diberi kutip tunggal ('' untuk kutip di dalamnya).
+enum class ExportFormat : uint8_t {
+    JsonLines,
+    Newick
+};
+
+// Newick untuk .nwk/.newick/.tre, selain itu JsonLines
+ExportFormat exportFormatFor(const std::string& filename);
+
+// Menambahkan text sebagai string JSON (dengan kutip) ke out
+void appendJsonString(BufferedWriter& out, std::string_view text);
+
+void exportTree(const Node* root, ExportFormat format, BufferedWriter& out);
+void exportTree(const Node* root, ExportFormat format, std::ostream& out);
+// "-" berarti stdout. false (dan pesan [ERROR]) jika file tidak bisa ditulis.
+bool exportTreeFile(const Node* root, ExportFormat format, const std::string& filename);
+
+#endif
@@ -0,0 +1,149 @@
+#include "fold.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FOLD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FOLD_SSE2 1
+#endif
+
+// --- SCALAR (SWAR) ---
+
+static const uint64_t ONES = 0x0101010101010101ull;
+static const uint64_t HIGH_BITS = 0x8080808080808080ull;
+
+static inline uint64_t load64(const char* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+static inline uint64_t loadTail(const char* p, size_t n) {
+    uint64_t word = 0;
+    std::memcpy(&word, p, n);
+    return word;
+}
+
+/**
+ * @brief Lowercases the 8 bytes of a word at once. A byte is 'A'..'Z' when adding
+ *        0x80-'A' sets its high bit but adding 0x80-'Z'-1 does not; bytes >= 0x80 are left alone.
+ */
+static inline uint64_t foldWord(uint64_t word) {
+    uint64_t low7 = word & ~HIGH_BITS;
+    uint64_t upper = ((low7 + (0x80 - 'A') * ONES) ^ (low7 + (0x80 - 'Z' - 1) * ONES)) & ~word & HIGH_BITS;
+    return word | (upper >> 2);
+}
+
+// --- SIMD ---
+
+#ifdef FOLD_SSE2
+static inline __m128i fold16(__m128i v) {
+    // perbandingan signed: byte >= 0x80 negatif, jadi tidak pernah dianggap huruf besar
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+#ifdef FOLD_AVX2
+static inline __m256i fold32(__m256i v) {
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+#endif
+
+// --- API ---
+
+void foldAssign(std::string& out, std::string_view in) {
+    out.resize(in.size());
+    const char* src = in.data();
+    char* dst = &out[0];
+    size_t n = in.size();
+    size_t i = 0;
+
+#ifdef FOLD_AVX2
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), fold32(v));
+    }
+#endif
+#ifdef FOLD_SSE2
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), fold16(v));
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word = foldWord(load64(src + i));
+        std::memcpy(dst + i, &word, sizeof(word));
+    }
+    for (; i < n; ++i) {
+        dst[i] = foldChar(src[i]);
+    }
+}
+
+bool equalsFolded(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    const char* pa = a.data();
+    const char* pb = b.data();
+    size_t n = a.size();
+    size_t i = 0;
+
+#ifdef FOLD_AVX2
+    for (; i + 32 <= n; i += 32) {
+        __m256i va = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa + i)));
+        __m256i vb = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + i)));
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xFFFFFFFFu) return false;
+    }
+#endif
+#ifdef FOLD_SSE2
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + i)));
+        __m128i vb = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + i)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF) return false;
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        if (foldWord(load64(pa + i)) != foldWord(load64(pb + i))) return false;
+    }
+    if (i < n) {
+        return foldWord(loadTail(pa + i, n - i)) == foldWord(loadTail(pb + i, n - i));
+    }
+    return true;
+}
+
+/**
+ * @brief Folds 8 bytes per step (SWAR) and mixes each word with a multiply-xorshift round.
+ *        Names are short, so this beats a SIMD reduction and gives the same value on every build.
+ */
+uint64_t hashFolded(std::string_view str) {
+    const uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+    const char* p = str.data();
+    size_t n = str.size();
+    uint64_t hash = n * MULTIPLIER;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        hash = (hash ^ foldWord(load64(p + i))) * MULTIPLIER;
+        hash ^= hash >> 29;
+    }
+    if (i < n) {
+        hash = (hash ^ foldWord(loadTail(p + i, n - i))) * MULTIPLIER;
+        hash ^= hash >> 29;
+    }
+    hash *= MULTIPLIER;
+    return hash ^ (hash >> 32);
+}
+
+const char* foldKernelName() {
+#if defined(FOLD_AVX2)
+    return "avx2";
+#elif defined(FOLD_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,34 @@
+#ifndef FOLD_H
+#define FOLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Case folding ASCII tanpa alokasi (hasilnya sama dengan std::tolower di locale "C").
+// Jalur cepat AVX2/SSE2 dipilih saat compile (-mavx2 / x86-64), selain itu fallback
+// scalar 8 byte per langkah (SWAR).
+
+inline char foldChar(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// out = lowercase(in); kapasitas out dipakai ulang
+void foldAssign(std::string& out, std::string_view in);
+bool equalsFolded(std::string_view a, std::string_view b);
+// Hash yang tidak membedakan huruf besar/kecil: hashFolded("Lamnidae") == hashFolded("LAMNIDAE")
+uint64_t hashFolded(std::string_view str);
+// Nama jalur yang dipakai saat compile: "avx2", "sse2" atau "scalar"
+const char* foldKernelName();
+
+// untuk unordered_map/unordered_set dengan key string_view case-insensitive
+struct FoldedHash {
+    size_t operator()(std::string_view str) const { return static_cast<size_t>(hashFolded(str)); }
+};
+
+struct FoldedEqual {
+    bool operator()(std::string_view a, std::string_view b) const { return equalsFolded(a, b); }
+};
+
+#endif
@@ -0,0 +1,278 @@
+#include "forest.h"
+#include "parallel.h"
+#include <algorithm>
+
+void InsertCounts::count(InsertResult result) {
+    switch (result) {
+        case InsertResult::Added:     ++added; break;
+        case InsertResult::Updated:   ++updated; break;
+        case InsertResult::Unchanged: ++unchanged; break;
+        case InsertResult::Rejected:  ++rejected; break;
+    }
+}
+
+InsertCounts& InsertCounts::operator+=(const InsertCounts& other) {
+    added += other.added;
+    updated += other.updated;
+    unchanged += other.unchanged;
+    rejected += other.rejected;
+    return *this;
+}
+
+Forest::Forest(Rank shardBy) : shardBy_(shardBy == Rank::Class ? Rank::Class : Rank::Order) {}
+
+Forest::~Forest() {
+    for (Shard& shard : shards_) deleteTree(shard.root);
+}
+
+uint32_t Forest::shardOf(const Node* node) const {
+    if (node == nullptr) return NONE;
+    auto it = shardByContext_.find(node->ctx);
+    return it == shardByContext_.end() ? NONE : it->second;
+}
+
+std::string_view Forest::shardKey(const std::string_view* path, std::string& scratch) const {
+    if (shardBy_ == Rank::Class) return path[0];
+    scratch.assign(path[0].data(), path[0].size()).append(1, '\t').append(path[1].data(), path[1].size());
+    return scratch;
+}
+
+uint32_t Forest::shardFor(const std::string_view* path) {
+    std::string_view key = shardKey(path, keyScratch_);
+    auto it = shardByKey_.find(key);
+    if (it != shardByKey_.end()) return it->second;
+
+    Shard shard;
+    shard.key = keys_.intern(std::string(key));
+    uint32_t index = static_cast<uint32_t>(shards_.size());
+    shards_.push_back(shard);
+    shardByKey_.emplace(shard.key.str(), index);
+    return index;
+}
+
+uint32_t Forest::findShard(const std::string_view* path) const {
+    std::string scratch;
+    auto it = shardByKey_.find(shardKey(path, scratch));
+    return it == shardByKey_.end() ? NONE : it->second;
+}
+
+/**
+ * @brief Adds index to the shard list of a name hash. Most names live in one shard, so the
+ *        shard index is stored inline; only names in several shards get a sorted list.
+ */
+void Forest::registerName(uint64_t hash, uint32_t index) {
+    auto inserted = names_.emplace(hash, index);
+    uint32_t& value = inserted.first->second;
+    if (inserted.second || value == index) return;
+
+    if ((value & SHARED_NAME) == 0) {
+        sharedNames_.push_back({std::min(value, index), std::max(value, index)});
+        value = SHARED_NAME | static_cast<uint32_t>(sharedNames_.size() - 1);
+        return;
+    }
+    std::vector<uint32_t>& shards = sharedNames_[value & ~SHARED_NAME];
+    auto pos = std::lower_bound(shards.begin(), shards.end(), index);
+    if (pos == shards.end() || *pos != index) shards.insert(pos, index);
+}
+
+// hash setiap key di name index tree (nama taksonomi & common name)
+static void collectNames(const Node* root, std::vector<uint64_t>& hashes) {
+    hashes.reserve(hashes.size() + root->ctx->nameIndex.size());
+    for (const auto& entry : root->ctx->nameIndex) hashes.push_back(hashFolded(entry.first));
+}
+
+void Forest::indexShard(uint32_t index) {
+    Node* root = shards_[index].root;
+    if (root == nullptr) return;
+    shardByContext_[root->ctx] = index;
+    std::vector<uint64_t> hashes;
+    collectNames(root, hashes);
+    for (uint64_t hash : hashes) registerName(hash, index);
+}
+
+void Forest::rebuildNameIndex() {
+    names_.clear();
+    sharedNames_.clear();
+    for (uint32_t i = 0; i < shardCount(); ++i) indexShard(i);
+}
+
+InsertResult Forest::insert(const std::vector<std::string_view>& path, std::string_view commonName, std::string_view wikiLink) {
+    if (path.size() != REQUIRED_TAX_LEVELS) return InsertResult::Rejected;
+
+    uint32_t index = shardFor(path.data());
+    Shard& shard = shards_[index];
+    InsertResult result = insertSpeciesRecord(shard.root, path, commonName, wikiLink);
+    if (result == InsertResult::Added || result == InsertResult::Updated) {
+        shardByContext_[shard.root->ctx] = index;
+        for (std::string_view name : path) registerName(hashFolded(name), index);
+        if (!commonName.empty()) registerName(hashFolded(commonName), index);
+    }
+    return result;
+}
+
+/**
+ * @brief Routes records to shards on the calling thread, then builds every touched shard
+ *        as its own task. Shards share no state, so the tasks need no locks. Each task also
+ *        hashes the names it brought in; only merging those hashes into the global index
+ *        runs on the calling thread afterwards.
+ */
+InsertCounts Forest::insertAll(const std::vector<SpeciesRecord>& records, ThreadPool* pool) {
+    std::vector<std::vector<uint32_t>> perShard;
+    for (size_t i = 0; i < records.size(); ++i) {
+        uint32_t index = shardFor(records[i].path);
+        if (perShard.size() <= index) perShard.resize(shards_.size());
+        perShard[index].push_back(static_cast<uint32_t>(i));
+    }
+
+    std::vector<uint32_t> touched;
+    for (uint32_t index = 0; index < perShard.size(); ++index) {
+        if (!perShard[index].empty()) touched.push_back(index);
+    }
+
+    std::vector<InsertCounts> counts(touched.size());
+    std::vector<std::vector<uint64_t>> hashes(touched.size());
+    auto build = [&](size_t t) {
+        Node*& root = shards_[touched[t]].root;
+        // shard yang masih kosong: semua namanya diambil sekali dari name index-nya
+        bool fresh = root == nullptr;
+        uint64_t previous[RANK_COUNT] = {};
+        std::vector<std::string_view> path(REQUIRED_TAX_LEVELS);
+        for (uint32_t r : perShard[touched[t]]) {
+            const SpeciesRecord& record = records[r];
+            std::copy(record.path, record.path + REQUIRED_TAX_LEVELS, path.begin());
+            counts[t].count(insertSpeciesRecord(root, path, record.commonName, record.wikiLink));
+            if (fresh) continue;
+
+            // ancestor yang sama dengan record sebelumnya tidak perlu didaftarkan lagi
+            for (size_t level = 0; level < REQUIRED_TAX_LEVELS; ++level) {
+                uint64_t hash = hashFolded(record.path[level]);
+                if (hash != previous[level]) hashes[t].push_back(hash);
+                previous[level] = hash;
+            }
+            if (!record.commonName.empty()) hashes[t].push_back(hashFolded(record.commonName));
+        }
+        if (fresh && root) collectNames(root, hashes[t]);
+    };
+
+    ThreadPool& workers = pool ? *pool : defaultThreadPool();
+    if (touched.size() < 2 || workers.size() < 2) {
+        for (size_t t = 0; t < touched.size(); ++t) build(t);
+    } else {
+        TaskGroup group(workers);
+        for (size_t t = 0; t < touched.size(); ++t) {
+            group.run([&, t] { build(t); });
+        }
+        group.wait();
+    }
+
+    InsertCounts total;
+    for (size_t t = 0; t < touched.size(); ++t) {
+        total += counts[t];
+        Node* root = shards_[touched[t]].root;
+        if (root) shardByContext_[root->ctx] = touched[t];
+        for (uint64_t hash : hashes[t]) registerName(hash, touched[t]);
+    }
+    return total;
+}
+
+bool Forest::update(Node* species, std::string_view commonName, std::string_view wikiLink) {
+    uint32_t index = shardOf(species);
+    if (index == NONE || !updateSpeciesRecord(species, commonName, wikiLink)) return false;
+    if (!commonName.empty()) registerName(hashFolded(commonName), index);
+    return true;
+}
+
+size_t Forest::remove(const std::string& speciesName) {
+    size_t removed = 0;
+    for (uint32_t index : candidateShards(speciesName)) {
+        removed += deleteSpeciesRecord(shards_[index].root, speciesName);
+    }
+    return removed;
+}
+
+ShardRange Forest::candidateShards(std::string_view name) const {
+    ShardRange range;
+    auto it = names_.find(hashFolded(name));
+    if (it == names_.end()) return range;
+    if ((it->second & SHARED_NAME) == 0) {
+        range.first = &it->second;
+        range.last = range.first + 1;
+    } else {
+        const std::vector<uint32_t>& shards = sharedNames_[it->second & ~SHARED_NAME];
+        range.first = shards.data();
+        range.last = shards.data() + shards.size();
+    }
+    return range;
+}
+
+Node* Forest::search(const std::string& name) const {
+    for (uint32_t index : candidateShards(name)) {
+        if (Node* found = searchNode(shards_[index].root, name)) return found;
+    }
+    return nullptr;
+}
+
+Node* Forest::findPath(const std::vector<std::string>& path) const {
+    if (path.empty()) return nullptr;
+
+    size_t keyLevels = static_cast<size_t>(shardBy_) + 1;
+    if (path.size() < keyLevels) {
+        // hanya nama Class pada mode Order: root shard pertama dengan Class itu
+        for (const Shard& shard : shards_) {
+            if (shard.root && equalsFolded(shard.root->name.str(), path[0])) return shard.root;
+        }
+        return nullptr;
+    }
+
+    std::string_view key[RANK_COUNT];
+    for (size_t level = 0; level < keyLevels; ++level) key[level] = path[level];
+    uint32_t index = findShard(key);
+    return index == NONE ? nullptr : ::findPath(shards_[index].root, path);
+}
+
+size_t Forest::speciesCount() const {
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        if (shard.root) total += ::speciesCount(shard.root);
+    }
+    return total;
+}
+
+/**
+ * @brief Picks the shards a pattern can match, then runs one cursor per shard in shard order.
+ */
+std::string queryForest(const Forest& forest, std::string_view pattern, const QueryFilter& filter,
+                        const std::function<void(Node*)>& visit) {
+    bool anchored = !pattern.empty() && pattern.front() == '/';
+    std::string_view rest = anchored ? pattern.substr(1) : pattern;
+    std::string_view first = rest.substr(0, rest.find('/'));
+    bool wildcard = first.find_first_of("*?") != std::string_view::npos;
+
+    std::vector<uint32_t> shards;
+    if (anchored) {
+        for (uint32_t i = 0; i < forest.shardCount(); ++i) {
+            const Node* root = forest.shard(i);
+            if (root == nullptr) continue;
+            bool match = wildcard ? globMatchFolded(first, root->name.str()) : equalsFolded(first, root->name.str());
+            if (match) shards.push_back(i);
+        }
+    } else if (!wildcard && !first.empty()) {
+        ShardRange candidates = forest.candidateShards(first);
+        shards.assign(candidates.begin(), candidates.end());
+    } else {
+        for (uint32_t i = 0; i < forest.shardCount(); ++i) {
+            if (forest.shard(i)) shards.push_back(i);
+        }
+    }
+
+    if (shards.empty()) {
+        // tetap compile pola supaya pola yang salah dilaporkan walau tidak ada shard yang cocok
+        return queryPath(nullptr, pattern, filter).error();
+    }
+    for (uint32_t index : shards) {
+        QueryCursor cursor = queryPath(forest.shard(index), pattern, filter);
+        if (!cursor.error().empty()) return cursor.error();
+        for (Node* node : cursor) visit(node);
+    }
+    return std::string();
+}
@@ -0,0 +1,135 @@
+#ifndef FOREST_H
+#define FOREST_H
+
+#include "tree.h"
+#include "query.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+// --- FOREST (SHARDED) ---
+// Satu tree hanya punya satu Class (addSpeciesPath menolak Class lain). Forest menyimpan
+// beberapa tree independen (shard) di balik satu facade: satu shard per Class, atau per
+// (Class, Order) supaya taksonomi dengan satu Class pun bisa dibangun paralel. Pada mode
+// Order setiap shard tetap tree lengkap: root Class-nya sendiri dengan satu Order di bawahnya.
+// Setiap shard punya TreeContext sendiri (arena, string pool, name index), jadi shard yang
+// berbeda boleh diubah dari thread berbeda tanpa lock.
+//
+// Indeks nama global memetakan hashFolded nama taksonomi & common name ke shard yang
+// memuatnya, sehingga search hanya menyentuh shard yang mungkin cocok. Nama tidak disalin
+// (cukup hash 64-bit), jadi indeks ini superset: tabrakan hash dan nama yang sudah dihapus
+// dari shard (sampai rebuildNameIndex()) hanya berarti satu lookup sia-sia di shard itu.
+
+// satu baris data untuk insertAll; view hanya disalin saat node baru dibuat
+struct SpeciesRecord {
+    std::string_view path[RANK_COUNT];  // Class..Species
+    std::string_view commonName;
+    std::string_view wikiLink;
+};
+
+// jumlah hasil insert per InsertResult
+struct InsertCounts {
+    size_t added = 0;
+    size_t updated = 0;
+    size_t unchanged = 0;
+    size_t rejected = 0;
+
+    void count(InsertResult result);
+    InsertCounts& operator+=(const InsertCounts& other);
+};
+
+// daftar index shard yang urut naik, menunjuk ke dalam Forest (valid sampai forest diubah)
+struct ShardRange {
+    const uint32_t* first = nullptr;
+    const uint32_t* last = nullptr;
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+class Forest {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    // shardBy: Rank::Class atau Rank::Order (rank lain diperlakukan sebagai Order)
+    explicit Forest(Rank shardBy = Rank::Class);
+    Forest(const Forest&) = delete;
+    Forest& operator=(const Forest&) = delete;
+    ~Forest();
+
+    Rank shardBy() const { return shardBy_; }
+    uint32_t shardCount() const { return static_cast<uint32_t>(shards_.size()); }
+    // root (Class) shard; nullptr sampai species pertama masuk ke shard itu
+    Node* shard(uint32_t index) const { return shards_[index].root; }
+    // shard tempat node berada, NONE jika node bukan milik forest ini
+    uint32_t shardOf(const Node* node) const;
+
+    // shard untuk path Class..Species (cukup sampai rank shardBy); dibuat jika belum ada
+    uint32_t shardFor(const std::string_view* path);
+    // seperti shardFor tanpa membuat shard baru; NONE jika belum ada
+    uint32_t findShard(const std::string_view* path) const;
+
+    // --- PERUBAHAN ---
+    // insertSpeciesRecord ke shard yang sesuai, lalu nama path didaftarkan ke indeks global
+    InsertResult insert(const std::vector<std::string_view>& path, std::string_view commonName, std::string_view wikiLink);
+    // Membangun banyak record sekaligus: record dibagi per shard (urutan per shard tetap),
+    // lalu setiap shard dibangun oleh satu task di pool (nullptr = defaultThreadPool()).
+    InsertCounts insertAll(const std::vector<SpeciesRecord>& records, ThreadPool* pool = nullptr);
+    // updateSpeciesRecord; common name baru didaftarkan ke indeks global
+    bool update(Node* species, std::string_view commonName, std::string_view wikiLink);
+    // deleteSpeciesRecord di setiap shard yang mungkin memuat nama itu
+    size_t remove(const std::string& speciesName);
+
+    // --- PENCARIAN ---
+    // Shard yang mungkin memuat node bernama name, urut naik (kosong jika nama tidak dikenal)
+    ShardRange candidateShards(std::string_view name) const;
+    // searchNode di shard kandidat; shard dengan index terkecil menang
+    Node* search(const std::string& name) const;
+    // Mengikuti path dari Class ke bawah di shard yang sesuai, nullptr jika putus
+    Node* findPath(const std::vector<std::string>& path) const;
+    size_t speciesCount() const;
+
+    // Mendaftarkan semua nama di name index satu shard ke indeks global
+    void indexShard(uint32_t index);
+    // Menyusun ulang indeks global dari semua shard (membuang nama yang sudah dihapus)
+    void rebuildNameIndex();
+
+private:
+    struct Shard {
+        Node* root = nullptr;
+        InternedName key;   // Class, atau Class<TAB>Order
+    };
+
+    // bit teratas value names_: nama ada di beberapa shard, sisanya index ke sharedNames_
+    static constexpr uint32_t SHARED_NAME = 0x80000000u;
+
+    std::string_view shardKey(const std::string_view* path, std::string& scratch) const;
+    void registerName(uint64_t hash, uint32_t index);
+
+    Rank shardBy_;
+    std::vector<Shard> shards_;
+    StringPool keys_;   // pemilik key shard
+    std::unordered_map<std::string_view, uint32_t, FoldedHash, FoldedEqual> shardByKey_;
+    std::unordered_map<const TreeContext*, uint32_t> shardByContext_;
+    std::unordered_map<uint64_t, uint32_t> names_;       // hashFolded(nama) -> shard atau SHARED_NAME | slot
+    std::vector<std::vector<uint32_t>> sharedNames_;
+    std::string keyScratch_;
+};
+
+// Menjalankan queryPath di setiap shard yang mungkin cocok, dalam urutan shard. Pola
+// berjangkar ("/Class/...") memilih shard dari nama Class-nya; segmen pertama berupa
+// nama persis memakai indeks nama global; selain itu semua shard ditanya. visit dipanggil
+// untuk setiap hasil. Mengembalikan pesan kesalahan pola, kosong jika pola valid.
+// Pada mode Order, node Class muncul sekali per shard.
+std::string queryForest(const Forest& forest, std::string_view pattern, const QueryFilter& filter,
+                        const std::function<void(Node*)>& visit);
+
+#endif
@@ -0,0 +1,164 @@
+#include "frozen.h"
+#include "traversal.h"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Lays the tree out in pre-order, then derives subtree ends, child ranges and level order
+ *        from the parent column in a few linear passes.
+ */
+void FrozenTree::rebuild(const Node* root) {
+    nodes_.clear();
+    names_.clear();
+    ranks_.clear();
+    ids_.clear();
+    parents_.clear();
+    subtreeEnd_.clear();
+    childOffsets_.clear();
+    childList_.clear();
+    levelOrder_.clear();
+    std::fill(std::begin(levelStart_), std::end(levelStart_), 0);
+    ctx_ = root ? root->ctx : nullptr;
+    if (root == nullptr) return;
+    revision_ = ctx_->revision;
+
+    // jumlah node sudah diketahui dari agregat subtree, jadi setiap kolom dialokasikan sekali
+    size_t count = descendantCount(root) + 1;
+    nodes_.reserve(count);
+    names_.reserve(count);
+    ranks_.reserve(count);
+    ids_.reserve(count);
+    parents_.reserve(count);
+    indexById_.assign(ctx_->nodes.idLimit(), NONE);
+
+    std::vector<std::pair<Node*, uint32_t>> stack;   // node, index parent-nya
+    stack.push_back({const_cast<Node*>(root), NONE});
+    while (!stack.empty()) {
+        Node* node = stack.back().first;
+        uint32_t parent = stack.back().second;
+        stack.pop_back();
+
+        uint32_t index = static_cast<uint32_t>(nodes_.size());
+        indexById_[node->id] = index;
+        nodes_.push_back(node);
+        names_.push_back(node->name.str());
+        ranks_.push_back(node->rank);
+        ids_.push_back(node->id);
+        parents_.push_back(parent);
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+            stack.push_back({*it, index});
+        }
+    }
+    uint32_t total = size();
+
+    // ukuran subtree dari belakang (anak selalu sesudah parent-nya), lalu diubah jadi batas akhir
+    subtreeEnd_.assign(total, 1);
+    for (uint32_t i = total; i-- > 1;) {
+        subtreeEnd_[parents_[i]] += subtreeEnd_[i];
+        subtreeEnd_[i] += i;
+    }
+
+    // anak pertama ada tepat sesudah parent, saudara berikutnya di akhir subtree saudara sebelumnya
+    childOffsets_.resize(total + 1);
+    childList_.reserve(total - 1);
+    for (uint32_t i = 0; i < total; ++i) {
+        childOffsets_[i] = static_cast<uint32_t>(childList_.size());
+        for (uint32_t child = i + 1; child < subtreeEnd_[i]; child = subtreeEnd_[child]) {
+            childList_.push_back(child);
+        }
+    }
+    childOffsets_[total] = static_cast<uint32_t>(childList_.size());
+
+    // urutan level-order sama dengan pre-order yang dikelompokkan per kedalaman (counting sort)
+    for (uint32_t i = 0; i < total; ++i) {
+        ++levelStart_[depth(i) + 1];
+    }
+    for (size_t d = 1; d <= RANK_COUNT; ++d) {
+        levelStart_[d] += levelStart_[d - 1];
+    }
+    uint32_t next[RANK_COUNT];
+    std::copy(levelStart_, levelStart_ + RANK_COUNT, next);
+    levelOrder_.resize(total);
+    for (uint32_t i = 0; i < total; ++i) {
+        levelOrder_[next[depth(i)]++] = i;
+    }
+}
+
+uint32_t FrozenTree::indexOf(const Node* node) const {
+    if (node == nullptr || node->ctx != ctx_ || node->id >= indexById_.size()) return NONE;
+    return indexById_[node->id];
+}
+
+/**
+ * @brief Name index lookup; the smallest index is the node a pre-order walk reaches first.
+ */
+uint32_t FrozenTree::search(std::string_view name) const {
+    if (ctx_ == nullptr) return NONE;
+    auto it = ctx_->nameIndex.find(name);
+    if (it == ctx_->nameIndex.end()) return NONE;
+
+    uint32_t best = NONE;
+    for (const Node* node : it->second) {
+        best = std::min(best, indexOf(node));
+    }
+    return best;
+}
+
+uint32_t FrozenTree::findChild(uint32_t parent, std::string_view name) const {
+    const Node* node = nodes_[parent];
+    return indexOf(node->childIndex.find(node->children, name));
+}
+
+uint32_t FrozenTree::findPath(const std::vector<std::string>& path) const {
+    if (empty() || path.empty() || !equalsFolded(names_[0], path[0])) return NONE;
+
+    uint32_t current = 0;
+    for (size_t level = 1; level < path.size() && current != NONE; ++level) {
+        current = findChild(current, path[level]);
+    }
+    return current;
+}
+
+// --- TRAVERSAL ---
+
+static void writeEntry(BufferedWriter& out, const FrozenTree& tree, uint32_t index) {
+    writeListingLine(out, tree.rank(index), tree.name(index), tree.commonName(index));
+}
+
+void displayTree(const FrozenTree& tree) {
+    BufferedWriter out(std::cout);
+    for (uint32_t i = 0; i < tree.size(); ++i) {
+        writeDisplayLine(out, tree.depth(i), tree.rank(i), tree.name(i), tree.commonName(i), !tree.wikiLink(i).empty());
+    }
+}
+
+void preOrderTraversal(const FrozenTree& tree) {
+    BufferedWriter out(std::cout);
+    for (uint32_t i = 0; i < tree.size(); ++i) {
+        writeEntry(out, tree, i);
+    }
+}
+
+void postOrderTraversal(const FrozenTree& tree) {
+    BufferedWriter out(std::cout);
+    // node dicetak saat seluruh subtree-nya sudah lewat
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i < tree.size(); ++i) {
+        while (!open.empty() && tree.subtreeEnd(open.back()) <= i) {
+            writeEntry(out, tree, open.back());
+            open.pop_back();
+        }
+        open.push_back(i);
+    }
+    while (!open.empty()) {
+        writeEntry(out, tree, open.back());
+        open.pop_back();
+    }
+}
+
+void levelOrderTraversal(const FrozenTree& tree) {
+    BufferedWriter out(std::cout);
+    for (uint32_t index : tree.levelOrder()) {
+        writeEntry(out, tree, index);
+    }
+}
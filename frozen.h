@@ -0,0 +1,83 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include "tree.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// --- FROZEN TREE ---
+// Bentuk read-only dari tree yang sedang dipakai, untuk beban kerja yang hampir selalu membaca:
+//   node disusun dalam array pre-order; subtree node i = [i, subtreeEnd(i))
+//   anak setiap node berurutan dalam satu array (CSR): [childrenBegin(i), childrenEnd(i))
+//   levelOrder() menyimpan urutan level-order, kedalaman d = [levelBegin(d), levelBegin(d + 1))
+// Pre-order dan level-order menjadi scan linear, dan "semua keturunan X" adalah satu range.
+// Nama, metadata, child index, dan name index dipinjam dari tree sumber sehingga rebuild
+// cukup satu traversal tanpa menyalin string. Hasilnya tidak valid lagi begitu tree sumber
+// diubah (lihat stale()): panggil rebuild() sesudah satu batch update. Untuk bentuk yang
+// berdiri sendiri di file, lihat SnapshotView (snapshot.h).
+class FrozenTree {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    FrozenTree() = default;
+    explicit FrozenTree(const Node* root) { rebuild(root); }
+
+    // root boleh berupa subtree; buffer dari build sebelumnya dipakai ulang
+    void rebuild(const Node* root);
+    // true jika tree sumber sudah berubah sejak rebuild() terakhir
+    bool stale() const { return ctx_ != nullptr && ctx_->revision != revision_; }
+
+    uint32_t size() const { return static_cast<uint32_t>(nodes_.size()); }
+    bool empty() const { return nodes_.empty(); }
+
+    // Node* agar hasil query bisa langsung dipakai API tree biasa; FrozenTree sendiri tidak mengubahnya
+    Node* node(uint32_t index) const { return nodes_[index]; }
+    std::string_view name(uint32_t index) const { return names_[index]; }
+    Rank rank(uint32_t index) const { return ranks_[index]; }
+    size_t depth(uint32_t index) const { return static_cast<size_t>(ranks_[index]) - static_cast<size_t>(ranks_[0]); }
+    std::string_view commonName(uint32_t index) const { return ctx_->commonNames.get(ids_[index]); }
+    std::string_view wikiLink(uint32_t index) const { return ctx_->wikiLinks.get(ids_[index]); }
+    uint32_t parent(uint32_t index) const { return parents_[index]; }   // NONE untuk root
+    uint32_t subtreeEnd(uint32_t index) const { return subtreeEnd_[index]; }
+    // keturunan index adalah [index + 1, subtreeEnd(index)), juga dalam pre-order
+    bool isAncestor(uint32_t ancestor, uint32_t index) const { return ancestor <= index && index < subtreeEnd_[ancestor]; }
+    const uint32_t* childrenBegin(uint32_t index) const { return childList_.data() + childOffsets_[index]; }
+    const uint32_t* childrenEnd(uint32_t index) const { return childList_.data() + childOffsets_[index + 1]; }
+    const std::vector<uint32_t>& levelOrder() const { return levelOrder_; }
+    uint32_t levelBegin(size_t depth) const { return levelStart_[depth < RANK_COUNT ? depth : RANK_COUNT]; }
+
+    // Query yang sama dengan tree biasa; hasilnya index, NONE jika tidak ada
+    uint32_t indexOf(const Node* node) const;
+    uint32_t search(std::string_view name) const;                       // seperti searchNode
+    uint32_t findChild(uint32_t parent, std::string_view name) const;
+    uint32_t findPath(const std::vector<std::string>& path) const;      // path[0] adalah nama root
+    size_t speciesCount(uint32_t index) const { return ::speciesCount(nodes_[index]); }
+
+private:
+    const TreeContext* ctx_ = nullptr;
+    uint64_t revision_ = 0;
+
+    // kolom per node, index = posisi pre-order
+    std::vector<Node*> nodes_;
+    std::vector<std::string_view> names_;
+    std::vector<Rank> ranks_;
+    std::vector<uint32_t> ids_;
+    std::vector<uint32_t> parents_;
+    std::vector<uint32_t> subtreeEnd_;
+    std::vector<uint32_t> childOffsets_;    // size() + 1 entri
+    std::vector<uint32_t> childList_;
+    std::vector<uint32_t> levelOrder_;
+    uint32_t levelStart_[RANK_COUNT + 1] = {};
+    std::vector<uint32_t> indexById_;       // id node -> index, NONE di luar tree ini
+};
+
+// Traversal dengan output yang sama dengan versi Node*
+void displayTree(const FrozenTree& tree);
+void preOrderTraversal(const FrozenTree& tree);
+void postOrderTraversal(const FrozenTree& tree);
+void levelOrderTraversal(const FrozenTree& tree);
+
+#endif
@@ -0,0 +1,317 @@
+#include "importer.h"
+#include "forest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// ukuran buffer baca; satu baris tidak boleh lebih panjang dari ini
+static const size_t READ_BUFFER_SIZE = 8 * 1024 * 1024;
+static const size_t MAX_REPORTED_ERRORS = 5;
+// import forest: teks yang ditahan sebelum shard dibangun (baris sudah dibagi per shard)
+static const size_t FOREST_FLUSH_BYTES = 256u << 20;
+
+/**
+ * @brief Splits one line into field views. Quoted fields that contain "" escapes are
+ * unescaped into unescaped[scratchUsed...]; everything else points straight into the line.
+ * Strings in a deque never move, so views stay valid until the caller resets scratchUsed.
+ * @return false if a quoted field is not closed.
+ */
+static bool splitFields(std::string_view line, char delimiter, std::vector<std::string_view>& fields,
+                        std::deque<std::string>& unescaped, size_t& scratchUsed) {
+    fields.clear();
+    size_t pos = 0;
+
+    while (true) {
+        if (pos < line.size() && line[pos] == '"') {
+            size_t start = ++pos;
+            bool hasEscapes = false;
+            while (true) {
+                size_t quote = line.find('"', pos);
+                if (quote == std::string_view::npos) return false;
+                if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                    hasEscapes = true;
+                    pos = quote + 2;
+                    continue;
+                }
+                pos = quote;
+                break;
+            }
+
+            std::string_view raw = line.substr(start, pos - start);
+            if (hasEscapes) {
+                if (scratchUsed == unescaped.size()) unescaped.emplace_back();
+                std::string& out = unescaped[scratchUsed++];
+                out.clear();
+                for (size_t i = 0; i < raw.size(); ++i) {
+                    out.push_back(raw[i]);
+                    if (raw[i] == '"') ++i;
+                }
+                fields.push_back(out);
+            } else {
+                fields.push_back(raw);
+            }
+
+            ++pos; // lewati kutip penutup
+            size_t next = line.find(delimiter, pos);
+            if (next == std::string_view::npos) break;
+            pos = next + 1;
+        } else {
+            size_t next = line.find(delimiter, pos);
+            if (next == std::string_view::npos) {
+                fields.push_back(line.substr(pos));
+                break;
+            }
+            fields.push_back(line.substr(pos, next - pos));
+            pos = next + 1;
+        }
+    }
+    return true;
+}
+
+static bool isHeaderRow(const std::vector<std::string_view>& fields) {
+    return !fields.empty() && equalsFolded(fields[0], TAX_LEVELS[0]);
+}
+
+// Pemeriksaan per baris yang sama untuk import tree dan forest: BOM, CRLF, deteksi
+// delimiter, header opsional, jumlah kolom, dan nama kosong.
+class RowParser {
+public:
+    RowParser(const std::string& filename, ImportStats& stats) : filename_(filename), stats_(stats) {}
+
+    // Satu baris tanpa '\n'. true jika baris berisi data valid (lihat fields()).
+    bool parse(std::string_view line) {
+        ++lineNumber_;
+        if (lineNumber_ == 1 && line.substr(0, 3) == "\xEF\xBB\xBF") line.remove_prefix(3);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) return false;
+
+        if (delimiter_ == 0) {
+            delimiter_ = (line.find('\t') != std::string_view::npos) ? '\t' : ',';
+        }
+
+        if (!splitFields(line, delimiter_, fields_, unescaped_, scratchUsed_)) {
+            reportMalformed("unterminated quoted field");
+            return false;
+        }
+        if (stats_.rows == 0 && stats_.malformed == 0 && isHeaderRow(fields_)) return false;
+
+        ++stats_.rows;
+        if (fields_.size() < REQUIRED_TOTAL_INPUTS) {
+            reportMalformed("expected Class..Species, common name and optional wiki link");
+            return false;
+        }
+        for (size_t i = 0; i < REQUIRED_TOTAL_INPUTS; ++i) {
+            if (fields_[i].empty()) {
+                reportMalformed("empty taxonomic or common name");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::vector<std::string_view>& fields() const { return fields_; }
+    std::string_view wikiLink() const {
+        return fields_.size() > REQUIRED_TOTAL_INPUTS ? fields_[REQUIRED_TOTAL_INPUTS] : std::string_view();
+    }
+    size_t lineNumber() const { return lineNumber_; }
+    // field hasil unescape dari baris-baris sebelumnya boleh ditimpa lagi
+    void releaseScratch() { scratchUsed_ = 0; }
+
+private:
+    void reportMalformed(const char* reason) {
+        ++stats_.malformed;
+        if (reportedErrors_++ < MAX_REPORTED_ERRORS) {
+            std::cerr << "[WARN] " << filename_ << ":" << lineNumber_ << ": " << reason << ", row skipped.\n";
+        }
+    }
+
+    const std::string& filename_;
+    ImportStats& stats_;
+    std::vector<std::string_view> fields_;
+    std::deque<std::string> unescaped_;
+    size_t scratchUsed_ = 0;
+    size_t lineNumber_ = 0;
+    size_t reportedErrors_ = 0;
+    char delimiter_ = 0;
+};
+
+static void countInsert(ImportStats& result, InsertResult insert) {
+    switch (insert) {
+        case InsertResult::Added:     ++result.added; break;
+        case InsertResult::Updated:   ++result.updated; break;
+        case InsertResult::Unchanged: ++result.unchanged; break;
+        case InsertResult::Rejected:  ++result.rejected; break;
+    }
+}
+
+/**
+ * @brief Streams a CSV/TSV taxonomy dump into the tree without per-insert logging.
+ */
+Node* importSpeciesFile(Node* root, const std::string& filename, ImportStats* stats) {
+    ImportStats local;
+    ImportStats& result = stats ? *stats : local;
+    result = ImportStats();
+
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        std::cerr << "[ERROR] Cannot open import file '" << filename << "'.\n";
+        return root;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<char> buffer(READ_BUFFER_SIZE);
+    RowParser parser(filename, result);
+    std::vector<std::string_view> path(REQUIRED_TAX_LEVELS);
+    size_t filled = 0;
+    bool eof = false;
+
+    while (!eof || filled > 0) {
+        if (!eof) {
+            size_t got = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file);
+            result.bytes += got;
+            filled += got;
+            eof = (got == 0);
+        }
+
+        size_t consumed = 0;
+        while (consumed < filled) {
+            const char* begin = buffer.data() + consumed;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', filled - consumed));
+            if (!newline && !eof) break;   // baris belum lengkap, baca lagi
+
+            size_t length = newline ? static_cast<size_t>(newline - begin) : filled - consumed;
+            consumed += length + (newline ? 1 : 0);
+
+            parser.releaseScratch();
+            if (!parser.parse(std::string_view(begin, length))) continue;
+
+            const std::vector<std::string_view>& fields = parser.fields();
+            std::copy(fields.begin(), fields.begin() + REQUIRED_TAX_LEVELS, path.begin());
+            countInsert(result, insertSpeciesRecord(root, path, fields[REQUIRED_TAX_LEVELS], parser.wikiLink()));
+        }
+
+        if (consumed == 0 && filled == buffer.size()) {
+            std::cerr << "[ERROR] " << filename << ":" << parser.lineNumber() + 1 << ": line longer than the "
+                      << READ_BUFFER_SIZE << "-byte read buffer. Import stopped.\n";
+            break;
+        }
+
+        // sisa baris yang belum lengkap dipindah ke depan buffer
+        std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+        if (eof) filled = 0;
+    }
+    std::fclose(file);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double rowsPerSecond = result.seconds > 0 ? result.rows / result.seconds : 0.0;
+
+    std::cout << "[IMPORT] " << filename << ": " << result.rows << " rows, "
+              << result.added << " added, " << result.updated << " updated, "
+              << result.unchanged << " unchanged, " << result.rejected << " rejected (other Class), "
+              << result.malformed << " malformed in " << result.seconds << " s ("
+              << static_cast<uint64_t>(rowsPerSecond) << " rows/s).\n";
+    return root;
+}
+
+/**
+ * @brief Reads the file in blocks that stay alive until the next flush, routes every row
+ *        to its shard, and builds the shards in parallel through Forest::insertAll.
+ */
+bool importForestFile(Forest& forest, const std::string& filename, ImportStats* stats, ThreadPool* pool) {
+    ImportStats local;
+    ImportStats& result = stats ? *stats : local;
+    result = ImportStats();
+
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        std::cerr << "[ERROR] Cannot open import file '" << filename << "'.\n";
+        return false;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+
+    RowParser parser(filename, result);
+    std::vector<std::unique_ptr<std::vector<char>>> blocks;   // teks yang ditunjuk records
+    std::vector<SpeciesRecord> records;
+    std::vector<char> carry;
+    size_t heldBytes = 0;
+    bool eof = false;
+    bool ok = true;
+
+    auto flush = [&] {
+        InsertCounts counts = forest.insertAll(records, pool);
+        result.added += counts.added;
+        result.updated += counts.updated;
+        result.unchanged += counts.unchanged;
+        result.rejected += counts.rejected;
+        records.clear();
+        blocks.clear();
+        parser.releaseScratch();
+        heldBytes = 0;
+    };
+
+    while (!eof) {
+        std::unique_ptr<std::vector<char>> block(new std::vector<char>(carry.size() + READ_BUFFER_SIZE));
+        std::vector<char>& text = *block;
+        std::copy(carry.begin(), carry.end(), text.begin());
+        size_t got = std::fread(text.data() + carry.size(), 1, READ_BUFFER_SIZE, file);
+        result.bytes += got;
+        eof = got < READ_BUFFER_SIZE;
+        text.resize(carry.size() + got);
+
+        // baris terakhir yang belum lengkap dibawa ke blok berikutnya
+        size_t complete = text.size();
+        if (!eof) {
+            auto newline = std::find(text.rbegin(), text.rend(), '\n');
+            complete = static_cast<size_t>(text.rend() - newline);
+            if (complete == 0 && text.size() >= READ_BUFFER_SIZE) {
+                std::cerr << "[ERROR] " << filename << ":" << parser.lineNumber() + 1 << ": line longer than the "
+                          << READ_BUFFER_SIZE << "-byte read buffer. Import stopped.\n";
+                ok = false;
+                break;
+            }
+        }
+        carry.assign(text.begin() + complete, text.end());
+        text.resize(complete);
+
+        size_t pos = 0;
+        while (pos < complete) {
+            const char* begin = text.data() + pos;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', complete - pos));
+            size_t length = newline ? static_cast<size_t>(newline - begin) : complete - pos;
+            pos += length + 1;
+            if (!parser.parse(std::string_view(begin, length))) continue;
+
+            const std::vector<std::string_view>& fields = parser.fields();
+            SpeciesRecord record;
+            std::copy(fields.begin(), fields.begin() + REQUIRED_TAX_LEVELS, record.path);
+            record.commonName = fields[REQUIRED_TAX_LEVELS];
+            record.wikiLink = parser.wikiLink();
+            records.push_back(record);
+        }
+
+        heldBytes += text.size();
+        blocks.push_back(std::move(block));
+        if (heldBytes >= FOREST_FLUSH_BYTES) flush();
+    }
+    flush();
+    std::fclose(file);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double rowsPerSecond = result.seconds > 0 ? result.rows / result.seconds : 0.0;
+
+    std::cout << "[IMPORT] " << filename << ": " << result.rows << " rows, "
+              << result.added << " added, " << result.updated << " updated, "
+              << result.unchanged << " unchanged into " << forest.shardCount() << " shards, "
+              << result.malformed << " malformed in " << result.seconds << " s ("
+              << static_cast<uint64_t>(rowsPerSecond) << " rows/s).\n";
+    return ok;
+}
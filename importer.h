@@ -0,0 +1,35 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include "tree.h"
+#include <cstdint>
+#include <string>
+
+class Forest;
+class ThreadPool;
+
+// ringkasan satu kali bulk import
+struct ImportStats {
+    size_t rows = 0;        // baris data (tanpa header dan baris kosong)
+    size_t added = 0;
+    size_t updated = 0;
+    size_t unchanged = 0;
+    size_t rejected = 0;    // Class berbeda dengan root tree (tidak terjadi pada forest)
+    size_t malformed = 0;   // kolom kurang atau nama kosong
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+};
+
+// --- BULK IMPORT ---
+// Membaca file CSV/TSV dengan kolom Class,Order,Family,Genus,Species,CommonName[,WikiLink].
+// Delimiter dideteksi dari baris pertama (tab atau koma), baris header opsional dilewati,
+// field CSV boleh diberi tanda kutip ("" untuk kutip di dalam field) tapi tidak boleh memuat newline.
+// File dibaca streaming dengan buffer besar; tidak ada log per insert, hanya satu baris ringkasan.
+Node* importSpeciesFile(Node* root, const std::string& filename, ImportStats* stats = nullptr);
+// Format sama, tetapi ke Forest sehingga Class berbeda tidak ditolak. Baris dibagi ke shard
+// saat dibaca; setiap shard dibangun oleh satu task di pool (nullptr = defaultThreadPool())
+// sesudah paling banyak 256 MiB teks terkumpul, lalu teks itu dilepas.
+// false jika file tidak bisa dibuka atau ada baris yang terlalu panjang.
+bool importForestFile(Forest& forest, const std::string& filename, ImportStats* stats = nullptr, ThreadPool* pool = nullptr);
+
+#endif
@@ -0,0 +1,80 @@
+#include "lca.h"
+#include "parallel.h"
+#include <algorithm>
+
+// di bawah jumlah ini pasangan dijawab di thread pemanggil
+static const size_t PARALLEL_MIN_PAIRS = 1024;
+
+/**
+ * @brief Fills one row per node: the parent's row (already built, parents come first in
+ *        pre-order) plus the node itself at its own depth.
+ */
+void LcaIndex::rebuild(const FrozenTree& tree) {
+    tree_ = &tree;
+    ancestors_.assign(static_cast<size_t>(tree.size()) * RANK_COUNT, FrozenTree::NONE);
+
+    for (uint32_t i = 0; i < tree.size(); ++i) {
+        uint32_t* ancestors = ancestors_.data() + static_cast<size_t>(i) * RANK_COUNT;
+        size_t depth = tree.depth(i);
+        if (depth > 0) std::copy(row(tree.parent(i)), row(tree.parent(i)) + depth, ancestors);
+        ancestors[depth] = i;
+    }
+}
+
+uint32_t LcaIndex::lowestCommonAncestor(uint32_t a, uint32_t b) const {
+    if (a == FrozenTree::NONE || b == FrozenTree::NONE) return FrozenTree::NONE;
+
+    const uint32_t* rowA = row(a);
+    const uint32_t* rowB = row(b);
+    // kedalaman 0 selalu root, jadi loop pasti berhenti
+    size_t depth = std::min(tree_->depth(a), tree_->depth(b));
+    while (rowA[depth] != rowB[depth]) --depth;
+    return rowA[depth];
+}
+
+uint32_t LcaIndex::distance(uint32_t a, uint32_t b) const {
+    uint32_t ancestor = lowestCommonAncestor(a, b);
+    if (ancestor == FrozenTree::NONE) return 0;
+    return static_cast<uint32_t>(tree_->depth(a) + tree_->depth(b) - 2 * tree_->depth(ancestor));
+}
+
+static SharedAncestor answerPair(const LcaIndex& index, const std::pair<std::string, std::string>& pair) {
+    const FrozenTree& tree = index.tree();
+    uint32_t a = tree.search(pair.first);
+    uint32_t b = tree.search(pair.second);
+    uint32_t ancestor = index.lowestCommonAncestor(a, b);
+
+    SharedAncestor result;
+    if (ancestor != FrozenTree::NONE) {
+        result.ancestor = tree.node(ancestor);
+        result.distance = index.distance(a, b);
+    }
+    return result;
+}
+
+/**
+ * @brief Name lookups dominate, so pairs are split into contiguous slices, one task per slice.
+ */
+std::vector<SharedAncestor> sharedAncestors(const LcaIndex& index,
+                                            const std::vector<std::pair<std::string, std::string>>& pairs,
+                                            ThreadPool* pool) {
+    std::vector<SharedAncestor> results(pairs.size());
+    size_t count = pairs.size();
+    ThreadPool& workers = pool ? *pool : defaultThreadPool();
+    if (count < PARALLEL_MIN_PAIRS || workers.size() < 2) {
+        for (size_t i = 0; i < count; ++i) results[i] = answerPair(index, pairs[i]);
+        return results;
+    }
+
+    size_t tasks = std::min(workers.size() * 4, count / (PARALLEL_MIN_PAIRS / 2));
+    size_t perTask = (count + tasks - 1) / tasks;
+    TaskGroup group(workers);
+    for (size_t t = 0; t < tasks; ++t) {
+        group.run([&, t] {
+            size_t first = t * perTask, last = std::min(count, first + perTask);
+            for (size_t i = first; i < last; ++i) results[i] = answerPair(index, pairs[i]);
+        });
+    }
+    group.wait();
+    return results;
+}
@@ -0,0 +1,52 @@
+#ifndef LCA_H
+#define LCA_H
+
+#include "frozen.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
+
+// --- LOWEST COMMON ANCESTOR ---
+// Indeks ancestor di atas FrozenTree. Rank sama dengan kedalaman (paling banyak RANK_COUNT
+// level), jadi setiap node menyimpan ancestor-nya di setiap kedalaman: binary lifting dengan
+// semua lompatan sudah dihitung, 4 byte per level per node. LCA dua node adalah ancestor
+// terdalam yang sama di kedua baris, O(RANK_COUNT) tanpa menyentuh Node. Seperti
+// FrozenTree, indeks harus dibangun ulang (rebuild) sesudah tree sumber berubah.
+class LcaIndex {
+public:
+    LcaIndex() = default;
+    explicit LcaIndex(const FrozenTree& tree) { rebuild(tree); }
+
+    // tree harus tetap hidup (dan tidak di-rebuild) selama indeks dipakai
+    void rebuild(const FrozenTree& tree);
+    const FrozenTree& tree() const { return *tree_; }
+
+    // index FrozenTree dari ancestor bersama terdalam; NONE jika a atau b NONE
+    uint32_t lowestCommonAncestor(uint32_t a, uint32_t b) const;
+    // jumlah langkah rank dari a naik ke LCA lalu turun ke b (0 jika a == b)
+    uint32_t distance(uint32_t a, uint32_t b) const;
+
+private:
+    const uint32_t* row(uint32_t index) const { return ancestors_.data() + static_cast<size_t>(index) * RANK_COUNT; }
+
+    const FrozenTree* tree_ = nullptr;
+    std::vector<uint32_t> ancestors_;   // baris per node: ancestor di kedalaman 0..depth(node)
+};
+
+// hasil untuk satu pasangan nama
+struct SharedAncestor {
+    Node* ancestor = nullptr;   // nullptr jika salah satu nama tidak ditemukan
+    uint32_t distance = 0;      // langkah rank A -> ancestor -> B
+};
+
+// Setiap nama dicari seperti searchNode (node pertama dalam pre-order jika ada beberapa).
+// Pasangan dibagi ke beberapa task di pool (nullptr = defaultThreadPool()); urutan hasil
+// sama dengan urutan input.
+std::vector<SharedAncestor> sharedAncestors(const LcaIndex& index,
+                                            const std::vector<std::pair<std::string, std::string>>& pairs,
+                                            ThreadPool* pool = nullptr);
+
+#endif
@@ -0,0 +1,281 @@
+// Load client untuk server mode (main --serve): mengukur QPS dan latency per request.
+// Build:     g++ -std=c++17 -O2 -pthread -o loadclient loadclient.cpp
+// Jalankan:  ./loadclient --socket PATH [--connections C] [--pipeline P] [--requests N] [--writes PCT] [--seed S]
+//   --socket       path Unix domain socket server
+//   --connections  jumlah koneksi paralel, satu thread per koneksi (default 4)
+//   --pipeline     request yang boleh menunggu response per koneksi (default 16)
+//   --requests     total request untuk semua koneksi (default 100000)
+//   --writes       persen request yang berupa Update common name, sisanya Search (default 0)
+//   --seed         seed pemilihan species dan campuran request (default 42)
+// Nama species diambil sekali dari server lewat request Subtree tanpa nama.
+#include "protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+#ifndef _WIN32
+
+// --- SOCKET (blocking) ---
+
+static int connectTo(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) return -1;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t put = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (put < 0 && errno == EINTR) continue;
+        if (put <= 0) return false;
+        sent += static_cast<size_t>(put);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads more bytes into buffer; false when the server closed the connection.
+ */
+static bool receiveSome(int fd, std::string& buffer) {
+    char chunk[64 * 1024];
+    while (true) {
+        ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        buffer.append(chunk, static_cast<size_t>(got));
+        return true;
+    }
+}
+
+/**
+ * @brief Takes one complete response frame off the front of buffer.
+ */
+static bool takeFrame(std::string& buffer, size_t& offset, uint8_t& status, std::string_view& body) {
+    if (buffer.size() - offset < FRAME_HEADER_SIZE) return false;
+    uint32_t length = frameLength(buffer.data() + offset);
+    if (buffer.size() - offset - FRAME_HEADER_SIZE < length) return false;
+    const char* payload = buffer.data() + offset + FRAME_HEADER_SIZE;
+    status = length > 0 ? static_cast<uint8_t>(payload[0]) : 0xFF;
+    body = length > 0 ? std::string_view(payload + 1, length - 1) : std::string_view();
+    offset += FRAME_HEADER_SIZE + length;
+    return true;
+}
+
+/**
+ * @brief Sends one request and waits for its response (for setup, not measured).
+ */
+static bool roundTrip(int fd, RequestOp op, std::string_view args, uint8_t& status, std::string& body) {
+    std::string frame;
+    appendFrame(frame, static_cast<uint8_t>(op), args);
+    if (!sendAll(fd, frame)) return false;
+
+    std::string buffer;
+    size_t offset = 0;
+    std::string_view view;
+    while (!takeFrame(buffer, offset, status, view)) {
+        if (!receiveSome(fd, buffer)) return false;
+    }
+    body.assign(view.data(), view.size());
+    return true;
+}
+
+// --- BEBAN ---
+
+struct WorkerResult {
+    std::vector<double> latencies;      // mikrodetik, satu per response
+    uint64_t statusCount[3] = {0, 0, 0};
+    uint64_t otherStatus = 0;
+    bool failed = false;
+};
+
+/**
+ * @brief One connection: keeps up to `pipeline` requests in flight and times each response
+ *        against the moment its request was handed to the socket.
+ */
+static void runWorker(const std::string& path, const std::vector<std::string>& species, size_t requests,
+                      size_t pipeline, unsigned writePercent, uint32_t seed, WorkerResult& result) {
+    int fd = connectTo(path);
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> pick(0, species.size() - 1);
+    std::uniform_int_distribution<unsigned> percent(0, 99);
+    std::deque<Clock::time_point> inFlight;
+    std::string output, input, args;
+    size_t offset = 0, issued = 0;
+    result.latencies.reserve(requests);
+
+    while (result.latencies.size() < requests) {
+        output.clear();
+        while (issued < requests && inFlight.size() < pipeline) {
+            const std::string& name = species[pick(random)];
+            if (percent(random) < writePercent) {
+                args.assign(name).append("\tload-").append(std::to_string(issued));
+                appendFrame(output, static_cast<uint8_t>(RequestOp::Update), args);
+            } else {
+                appendFrame(output, static_cast<uint8_t>(RequestOp::Search), name);
+            }
+            ++issued;
+            inFlight.push_back(Clock::now());
+        }
+        if (!output.empty() && !sendAll(fd, output)) break;
+
+        if (!receiveSome(fd, input)) break;
+        uint8_t status;
+        std::string_view body;
+        while (!inFlight.empty() && takeFrame(input, offset, status, body)) {
+            auto now = Clock::now();
+            result.latencies.push_back(std::chrono::duration<double, std::micro>(now - inFlight.front()).count());
+            inFlight.pop_front();
+            if (status < 3) ++result.statusCount[status];
+            else ++result.otherStatus;
+        }
+        input.erase(0, offset);
+        offset = 0;
+    }
+    if (result.latencies.size() < requests) result.failed = true;
+    close(fd);
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+#endif
+
+int main(int argc, char* argv[]) {
+    std::string socketPath;
+    size_t connections = 4, pipeline = 16, requests = 100000;
+    unsigned writePercent = 0;
+    uint32_t seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue) {
+            socketPath = argv[++i];
+        } else if (arg == "--connections" && hasValue) {
+            connections = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--pipeline" && hasValue) {
+            pipeline = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--requests" && hasValue) {
+            requests = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--writes" && hasValue) {
+            writePercent = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            socketPath.clear();
+            break;
+        }
+    }
+    if (socketPath.empty() || connections == 0 || pipeline == 0 || requests == 0 || writePercent > 100) {
+        std::cerr << "Usage: loadclient --socket PATH [--connections C] [--pipeline P] [--requests N] [--writes PCT] [--seed S]\n";
+        return 1;
+    }
+
+#ifdef _WIN32
+    std::cerr << "Error: loadclient needs Unix domain sockets; the server only runs on Linux.\n";
+    return 1;
+#else
+    // daftar species dari server, sekaligus memastikan server bisa dihubungi
+    std::vector<std::string> species;
+    {
+        int fd = connectTo(socketPath);
+        uint8_t status = 0;
+        std::string listing;
+        if (fd < 0 || !roundTrip(fd, RequestOp::Subtree, "", status, listing) || status != static_cast<uint8_t>(ResponseStatus::Ok)) {
+            std::cerr << "Error: cannot fetch the tree from '" << socketPath << "'.\n";
+            if (fd >= 0) close(fd);
+            return 1;
+        }
+        close(fd);
+
+        const std::string prefix = "Species\t";
+        size_t pos = 0;
+        while (pos < listing.size()) {
+            size_t end = listing.find('\n', pos);
+            if (end == std::string::npos) end = listing.size();
+            if (listing.compare(pos, prefix.size(), prefix) == 0) {
+                size_t nameStart = pos + prefix.size();
+                size_t nameEnd = std::min(listing.find('\t', nameStart), end);
+                species.emplace_back(listing, nameStart, nameEnd - nameStart);
+            }
+            pos = end + 1;
+        }
+    }
+    if (species.empty()) {
+        std::cerr << "Error: the server has no species to query.\n";
+        return 1;
+    }
+    std::cout << "Species: " << species.size() << ", connections: " << connections << ", pipeline: " << pipeline
+              << ", requests: " << requests << ", writes: " << writePercent << "%\n";
+
+    std::vector<WorkerResult> results(connections);
+    std::vector<std::thread> workers;
+    auto started = Clock::now();
+    for (size_t c = 0; c < connections; ++c) {
+        size_t share = requests / connections + (c < requests % connections ? 1 : 0);
+        workers.emplace_back(runWorker, std::cref(socketPath), std::cref(species), share, pipeline, writePercent,
+                             seed + static_cast<uint32_t>(c), std::ref(results[c]));
+    }
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    std::vector<double> latencies;
+    uint64_t statusCount[3] = {0, 0, 0}, otherStatus = 0;
+    size_t failed = 0;
+    for (const WorkerResult& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        for (size_t s = 0; s < 3; ++s) statusCount[s] += result.statusCount[s];
+        otherStatus += result.otherStatus;
+        if (result.failed) ++failed;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("Completed:   %zu requests in %.3f s (%.0f req/s)\n", latencies.size(), seconds,
+                seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0);
+    std::printf("Latency us:  p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n", percentile(latencies, 0.50),
+                percentile(latencies, 0.90), percentile(latencies, 0.99), latencies.empty() ? 0.0 : latencies.back());
+    std::printf("Status:      ok %llu, not found %llu, invalid %llu, other %llu\n",
+                static_cast<unsigned long long>(statusCount[0]), static_cast<unsigned long long>(statusCount[1]),
+                static_cast<unsigned long long>(statusCount[2]), static_cast<unsigned long long>(otherStatus));
+    if (failed > 0) {
+        std::cerr << "Error: " << failed << " connection(s) failed before finishing.\n";
+        return 1;
+    }
+    return 0;
+#endif
+}
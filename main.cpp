@@ -2,10 +2,22 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <cstdio>
 #include <cstdlib> // For system()
 #include <algorithm> // For std::transform (used by toLower from tree.h)
 #include <cctype>    // For std::tolower (used by toLower from tree.h)
 #include "tree.h"  // Ensure tree.h is included
+#include "importer.h"
+#include "forest.h"
+#include "snapshot.h"
+#include "wal.h"
+#include "autocomplete.h"
+#include "metrics.h"
+#include "batch.h"
+#include "server.h"
+#include "exporter.h"
+#include "diff.h"
+#include "traversal.h"
 
 using namespace std;
 
@@ -38,33 +50,240 @@ void openWikipediaLink(const string& url) {
     cout << "\n[INFO] Attempting to open Wikipedia link: " << url << "\n";
     
     #ifdef _WIN32
-        string command = "start " + url;
-        // Execute the command
-        system(command.c_str());
+        string command = "start \"\" \"" + url + "\"";
+    #elif defined(__APPLE__)
+        string command = "open \"" + url + "\"";
     #else
+        string command = "xdg-open \"" + url + "\" >/dev/null 2>&1";
     #endif
 
-    system(command.c_str());
+    if (system(command.c_str()) != 0) {
+        cout << "[WARN] Could not open a browser; copy the link above instead.\n";
+    }
 }
 
 
-int main() {
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--snapshot <tree.snap>] [--import <taxonomy.csv|taxonomy.tsv>] [--batch <commands.txt|->] [--serve <socket>]\n"
+         << "       [--export <file|->] [--diff <other.snap>]\n"
+         << "       " << program << " --forest <taxonomy.csv|taxonomy.tsv> [--shard-by class|order] [--batch <commands.txt|->]\n"
+         << "  --snapshot  load the tree from this snapshot plus its operation log (<file>.wal),\n"
+         << "              log every change and write a new checkpoint on exit\n"
+         << "  --batch     run add/search/update/delete/dump/query commands from a file (- = stdin)\n"
+         << "              without the menu, then exit (format: see batch.h)\n"
+         << "  --serve     answer requests on this Unix domain socket until Ctrl+C (Linux only,\n"
+         << "              protocol: see protocol.h, load test: loadclient.cpp)\n"
+         << "  --export    write the tree as Newick (.nwk/.newick/.tre) or JSON Lines (anything else,\n"
+         << "              - = stdout as JSON Lines), then exit\n"
+         << "  --diff      print species added, removed or changed between this snapshot and the\n"
+         << "              loaded tree as JSON Lines on stdout, then exit\n"
+         << "  --forest    import rows of any Class into a sharded forest (shards built in parallel),\n"
+         << "              run the --batch commands against it and exit; not persisted\n"
+         << "  --shard-by  one shard per Class (default) or per Class and Order\n";
+}
+
+int main(int argc, char* argv[]) {
     Node* root = nullptr;
     int pilihan;
     int traversalChoice;
+    string importFile;
+    string snapshotFile;
+    string batchFile;
+    string socketPath;
+    string exportFile;
+    string diffFile;
+    string forestFile;
+    Rank shardBy = Rank::Class;
+    OperationLog operationLog;
+    AutocompleteIndex suggestions;       // dibangun saat pertama kali dibutuhkan
+    bool suggestionsStale = true;        // tree berubah sejak suggestions dibangun
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--import" && i + 1 < argc) {
+            importFile = argv[++i];
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotFile = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batchFile = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--export" && i + 1 < argc) {
+            exportFile = argv[++i];
+        } else if (arg == "--diff" && i + 1 < argc) {
+            diffFile = argv[++i];
+        } else if (arg == "--forest" && i + 1 < argc) {
+            forestFile = argv[++i];
+        } else if (arg == "--shard-by" && i + 1 < argc && (equalsFolded(argv[i + 1], "class") || equalsFolded(argv[i + 1], "order"))) {
+            shardBy = equalsFolded(argv[++i], "class") ? Rank::Class : Rank::Order;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // forest hanya hidup selama proses: tidak bisa digabung dengan snapshot, menu atau server
+    if (!forestFile.empty() && (!snapshotFile.empty() || !importFile.empty() || !socketPath.empty() ||
+                                !exportFile.empty() || !diffFile.empty())) {
+        cerr << "[ERROR] --forest can only be combined with --shard-by and --batch.\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (!forestFile.empty()) {
+        Forest forest(shardBy);
+        // pesan [IMPORT] ke stderr supaya stdout hanya berisi hasil batch
+        std::streambuf* previous = cout.rdbuf(cerr.rdbuf());
+        bool ok = importForestFile(forest, forestFile);
+        cout.rdbuf(previous);
+        if (!ok) return 1;
+        cerr << "[FOREST] " << forest.speciesCount() << " species in " << forest.shardCount() << " shards:";
+        for (uint32_t i = 0; i < forest.shardCount(); ++i) {
+            Node* shard = forest.shard(i);
+            if (shard == nullptr) continue;
+            cerr << ' ' << shard->name.str();
+            if (shardBy == Rank::Order && !shard->children.empty()) cerr << '/' << shard->children[0]->name.str();
+            cerr << " (" << speciesCount(shard) << ")";
+        }
+        cerr << "\n";
+        if (batchFile.empty()) return 0;
+
+        FILE* input = (batchFile == "-") ? stdin : fopen(batchFile.c_str(), "rb");
+        if (!input) {
+            cerr << "[ERROR] Cannot open batch file '" << batchFile << "'.\n";
+            return 1;
+        }
+        BatchStats stats;
+        ok = runForestBatch(forest, input, cout, &stats);
+        if (input != stdin) fclose(input);
+        cerr << "[BATCH] " << stats.commands << " commands (" << stats.adds << " add, " << stats.searches << " search, "
+             << stats.updates << " update, " << stats.deletes << " delete, " << stats.dumps << " dump, " << stats.queries << " query), "
+             << stats.malformed << " malformed in " << stats.seconds << " s.\n";
+        return ok ? 0 : 1;
+    }
+
+    // --export - dan --diff menulis data ke stdout; pesan [INFO]/[IMPORT] dialihkan ke stderr
+    std::streambuf* dataOutput = nullptr;
+    if (exportFile == "-" || !diffFile.empty()) dataOutput = cout.rdbuf(cerr.rdbuf());
+
+    if (!snapshotFile.empty()) {
+        uint64_t lastLsn = 0;
+        if (!recoverTree(snapshotFile, snapshotFile + ".wal", root, lastLsn) ||
+            !operationLog.open(snapshotFile + ".wal", lastLsn)) {
+            return 1;
+        }
+        if (root) {
+            cout << "[INFO] Recovered tree from '" << snapshotFile << "' (last operation #" << lastLsn << ").\n";
+        }
+    }
+
+    if (!importFile.empty()) {
+        root = importSpeciesFile(root, importFile);
+        // hasil import tidak dicatat per baris, jadi langsung dijadikan checkpoint; tanpa
+        // --snapshot image tidak dibangun sama sekali (argumen dievaluasi sebelum compact)
+        if (operationLog.isOpen() && !operationLog.failed()) {
+            operationLog.compact(buildSnapshotImage(root, operationLog.lastLsn()), operationLog.lastLsn(), snapshotFile, false);
+        }
+    }
+
+    if (!exportFile.empty() || !diffFile.empty()) {
+        if (dataOutput) cout.rdbuf(dataOutput);
+        bool ok = true;
+        if (!exportFile.empty()) {
+            ok = exportTreeFile(root, exportFormatFor(exportFile), exportFile);
+        }
+        if (ok && !diffFile.empty()) {
+            auto view = std::make_shared<SnapshotView>();
+            if (!view->open(diffFile)) {
+                cerr << "[ERROR] Cannot open snapshot '" << diffFile << "' for diff.\n";
+                ok = false;
+            } else {
+                // snapshot sebagai "before", tree yang sedang dimuat sebagai "after"
+                Node* other = loadSnapshotTree(view);
+                DiffStats stats;
+                {
+                    BufferedWriter out(cout);
+                    stats = diffTrees(other, root, [&](const DiffEntry& entry) { writeDiffEntry(out, entry); });
+                }
+                cerr << "[DIFF] '" << diffFile << "' -> current tree: " << stats.added << " added, " << stats.removed
+                     << " removed, " << stats.changed << " changed (" << stats.visited << " nodes compared).\n";
+                deleteTree(other);
+            }
+        }
+        if (operationLog.isOpen()) operationLog.close();
+        deleteTree(root);
+        return ok ? 0 : 1;
+    }
+
+    if (!batchFile.empty()) {
+        FILE* input = (batchFile == "-") ? stdin : fopen(batchFile.c_str(), "rb");
+        if (!input) {
+            cerr << "[ERROR] Cannot open batch file '" << batchFile << "'.\n";
+            deleteTree(root);
+            return 1;
+        }
+        BatchOptions options;
+        options.log = &operationLog;
+        options.snapshotFile = snapshotFile;
+        BatchStats stats;
+        bool ok = runBatch(root, input, cout, options, &stats);
+        if (input != stdin) fclose(input);
 
-    // --- Example Species Data ---
-    const vector<string> greatWhiteTax = {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"};
-    const string greatWhiteCommonName = "Great White Shark";
-    const string greatWhiteWiki = "https://en.wikipedia.org/wiki/Great_white_shark"; 
+        cerr << "[BATCH] " << stats.commands << " commands (" << stats.adds << " add, " << stats.searches << " search, "
+             << stats.updates << " update, " << stats.deletes << " delete, " << stats.dumps << " dump, " << stats.queries << " query), "
+             << stats.malformed << " malformed in " << stats.seconds << " s.\n";
+        if (operationLog.isOpen()) {
+            // sesudah log gagal, tree memuat perubahan yang sudah dilaporkan gagal: jangan di-checkpoint
+            if (!operationLog.failed()) {
+                operationLog.compact(buildSnapshotImage(root, operationLog.lastLsn()), operationLog.lastLsn(), snapshotFile, false);
+            }
+            operationLog.close();
+        }
+        deleteTree(root);
+        return ok ? 0 : 1;
+    }
+
+    if (!socketPath.empty()) {
+        ServerOptions options;
+        options.socketPath = socketPath;
+        options.log = &operationLog;
+        options.snapshotFile = snapshotFile;
+        ServerStats stats;
+        bool ok = runServer(root, options, &stats);
+
+        cerr << "[SERVER] " << stats.requests << " requests (" << stats.reads << " read, " << stats.writes << " write) in "
+             << stats.batches << " batches from " << stats.connections << " connections, " << stats.protocolErrors
+             << " protocol errors in " << stats.seconds << " s.\n";
+        if (operationLog.isOpen()) {
+            // sesudah log gagal, tree memuat perubahan yang sudah dilaporkan gagal: jangan di-checkpoint
+            if (!operationLog.failed()) {
+                operationLog.compact(buildSnapshotImage(root, operationLog.lastLsn()), operationLog.lastLsn(), snapshotFile, false);
+            }
+            operationLog.close();
+        }
+        deleteTree(root);
+        return ok ? 0 : 1;
+    }
+
+    if (root == nullptr) {
+        // --- Example Species Data ---
+        const vector<string> greatWhiteTax = {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"};
+        const string greatWhiteCommonName = "Great White Shark";
+        const string greatWhiteWiki = "https://en.wikipedia.org/wiki/Great_white_shark"; 
     
-    const vector<string> tigerSharkTax = {"Chondrichthyes", "Carcharhiniformes", "Carcharhinidae", "Galeocerdo", "cuvier"};
-    const string tigerSharkCommonName = "Tiger Shark";
-    const string tigerSharkWiki = "https://en.wikipedia.org/wiki/Tiger_shark"; 
+        const vector<string> tigerSharkTax = {"Chondrichthyes", "Carcharhiniformes", "Carcharhinidae", "Galeocerdo", "cuvier"};
+        const string tigerSharkCommonName = "Tiger Shark";
+        const string tigerSharkWiki = "https://en.wikipedia.org/wiki/Tiger_shark"; 
 
-    root = addSpeciesPath(root, greatWhiteTax, greatWhiteCommonName, greatWhiteWiki); 
-    root = addSpeciesPath(root, tigerSharkTax, tigerSharkCommonName, tigerSharkWiki); 
-    cout << "\n[INFO] Two example shark species have been pre-inserted.\n";
+        // dicatat juga agar replay setelah crash memulai dari data contoh yang sama
+        operationLog.logAdd(greatWhiteTax, greatWhiteCommonName, greatWhiteWiki);
+        if (operationLog.waitDurable(operationLog.logAdd(tigerSharkTax, tigerSharkCommonName, tigerSharkWiki))) {
+            root = addSpeciesPath(root, greatWhiteTax, greatWhiteCommonName, greatWhiteWiki); 
+            root = addSpeciesPath(root, tigerSharkTax, tigerSharkCommonName, tigerSharkWiki); 
+            cout << "\n[INFO] Two example shark species have been pre-inserted.\n";
+        } else {
+            cout << "\n[ERROR] Example species were not inserted: the operation log could not be written.\n";
+        }
+    }
 
 
     do {
@@ -75,7 +294,8 @@ int main() {
         cout << "4. Traversal Menu (R)\n";
         cout << "5. Update Species Details (U)\n";
         cout << "6. Delete Species (D)\n";
-        cout << "7. Exit\n";
+        cout << "7. Stats (metrics & memory)\n";
+        cout << "8. Exit\n";
         cout << "Pilih menu: ";
         
         if (!(cin >> pilihan)) { 
@@ -117,7 +337,12 @@ int main() {
                 cout << "Enter Wikipedia Link (URL, optional): ";
                 string wikiLinkInput = readInput(true);
                 
+                if (!operationLog.waitDurable(operationLog.logAdd(taxonomicPath, commonNameInput, wikiLinkInput))) {
+                    cout << "[ERROR] The operation log could not be written. Insertion aborted.\n";
+                    break;
+                }
                 root = addSpeciesPath(root, taxonomicPath, commonNameInput, wikiLinkInput); 
+                suggestionsStale = true;
                 
             } break;
             case 2: {
@@ -134,24 +359,46 @@ int main() {
                 Node* found = searchNode(root, searchName);
                 if (found) {
                     cout << "\n[SUCCESS] Data '" << searchName << "' ditemukan.\n";
-                    cout << "Level: " << found->level << "\n";
+                    cout << "Level: " << rankName(found->rank) << "\n";
                     cout << "Taxonomic Name: " << found->name << "\n";
-                    if (!found->commonName.empty()) {
-                        cout << "Common Name: " << found->commonName << "\n";
+                    if (!nodeCommonName(found).empty()) {
+                        cout << "Common Name: " << nodeCommonName(found) << "\n";
                     }
-                    if (!found->wikiLink.empty()) {
-                        cout << "Wikipedia Link: " << found->wikiLink << "\n";
+                    if (!nodeWikiLink(found).empty()) {
+                        cout << "Wikipedia Link: " << nodeWikiLink(found) << "\n";
                         cout << "Want to open the link now? (y/n): ";
                         string openChoice = readInput();
                         if (toLower(openChoice) == "y") { // toLower comes from tree.h/tree.cpp
-                            openWikipediaLink(found->wikiLink);
+                            openWikipediaLink(string(nodeWikiLink(found)));
                         }
-                    } else if (found->level == "Species") {
+                    } else if (found->rank == Rank::Species) {
                          cout << "[INFO] No Wikipedia link recorded for this species.\n";
                     }
                     cout << "Children Count: " << found->children.size() << "\n";
+                    if (found->rank != Rank::Species) {
+                        cout << "Species in Subtree: " << speciesCount(found) << " (" << linkedSpeciesCount(found) << " with Wikipedia link)\n";
+                        cout << "Descendants: " << descendantCount(found) << ", Subtree Depth: " << subtreeHeight(found) << "\n";
+                    }
                 } else {
                     cout << "[INFO] Data '" << searchName << "' tidak ditemukan.\n";
+
+                    if (suggestionsStale) {
+                        suggestions.build(root);
+                        suggestionsStale = false;
+                    }
+                    // nama yang diawali input dulu, kalau tidak ada baru nama yang mirip (salah ketik)
+                    vector<NameMatch> similar = suggestions.complete(searchName, 5);
+                    if (similar.empty()) {
+                        similar = suggestions.fuzzy(searchName, searchName.size() <= 4 ? 1 : 2, 5);
+                    }
+                    if (!similar.empty()) {
+                        cout << "Mungkin maksud Anda:\n";
+                        for (const NameMatch& match : similar) {
+                            cout << "  - " << rankName(match.node->rank) << ": " << match.node->name;
+                            if (!nodeCommonName(match.node).empty()) cout << " [" << nodeCommonName(match.node) << "]";
+                            cout << "\n";
+                        }
+                    }
                 }
             } break;
             case 3: {
@@ -210,13 +457,13 @@ int main() {
                 }
 
                 Node* speciesToUpdate = searchNode(root, updateSearchName);
-                if (speciesToUpdate && speciesToUpdate->level == "Species") {
-                    cout << "\n[FOUND] Species: " << speciesToUpdate->commonName << " (" << speciesToUpdate->name << ")\n";
+                if (speciesToUpdate && speciesToUpdate->rank == Rank::Species) {
+                    cout << "\n[FOUND] Species: " << nodeCommonName(speciesToUpdate) << " (" << speciesToUpdate->name << ")\n";
                     
-                    cout << "Enter NEW Common Name (Current: " << speciesToUpdate->commonName << "): ";
+                    cout << "Enter NEW Common Name (Current: " << nodeCommonName(speciesToUpdate) << "): ";
                     string newCommonName = readInput(true);
                     
-                    cout << "Enter NEW Wikipedia Link (Current: " << speciesToUpdate->wikiLink << "): ";
+                    cout << "Enter NEW Wikipedia Link (Current: " << nodeWikiLink(speciesToUpdate) << "): ";
                     string newWikiLink = readInput(true);
                     
                     if (newCommonName.empty()) {
@@ -224,10 +471,15 @@ int main() {
                         break;
                     }
 
+                    if (!operationLog.waitDurable(operationLog.logUpdate(nodePath(speciesToUpdate), newCommonName, newWikiLink))) {
+                        cout << "[ERROR] The operation log could not be written. Update aborted.\n";
+                        break;
+                    }
                     updateSpecies(speciesToUpdate, newCommonName, newWikiLink);
+                    suggestionsStale = true;
                     
-                } else if (speciesToUpdate && speciesToUpdate->level != "Species") {
-                    cout << "[ERROR] Found '" << updateSearchName << "' but it is a " << speciesToUpdate->level << ". Only SPECIES can be updated.\n";
+                } else if (speciesToUpdate && speciesToUpdate->rank != Rank::Species) {
+                    cout << "[ERROR] Found '" << updateSearchName << "' but it is a " << rankName(speciesToUpdate->rank) << ". Only SPECIES can be updated.\n";
                 } else {
                     cout << "[INFO] Species '" << updateSearchName << "' not found.\n";
                 }
@@ -244,29 +496,53 @@ int main() {
                 }
                 
                 Node* found = searchNode(root, deleteSearchName);
-                if (found && found->level == "Species") {
-                    cout << "Are you sure you want to delete species '" << found->commonName << " (" << found->name << ")'? (y/n): ";
+                if (found && found->rank == Rank::Species) {
+                    cout << "Are you sure you want to delete species '" << nodeCommonName(found) << " (" << found->name << ")'? (y/n): ";
                     string confirm = readInput();
                     if (toLower(confirm) == "y") {
                         // deleteSpecies dipanggil dengan root, nama spesies, dan parent default (nullptr)
+                        if (!operationLog.waitDurable(operationLog.logDelete(deleteSearchName))) {
+                            cout << "[ERROR] The operation log could not be written. Deletion aborted.\n";
+                            break;
+                        }
                         deleteSpecies(root, deleteSearchName); 
+                        suggestionsStale = true;
                     } else {
                         cout << "[INFO] Deletion cancelled.\n";
                     }
-                } else if (found && found->level != "Species") {
-                     cout << "[ERROR] Found '" << deleteSearchName << "' but it is a " << found->level << ". Only SPECIES can be deleted.\n";
+                } else if (found && found->rank != Rank::Species) {
+                     cout << "[ERROR] Found '" << deleteSearchName << "' but it is a " << rankName(found->rank) << ". Only SPECIES can be deleted.\n";
                 } else {
                     cout << "[INFO] Species '" << deleteSearchName << "' not found.\n";
                 }
             } break;
             case 7:
+                printMetrics(cout, root);
+                break;
+            case 8:
+                if (operationLog.isOpen()) {
+                    // sama seperti mode batch/server: sesudah log gagal jangan di-checkpoint
+                    if (operationLog.failed()) {
+                        cerr << "[ERROR] The operation log failed earlier; the tree was not saved to snapshot '"
+                             << snapshotFile << "'.\n";
+                    } else {
+                        operationLog.compact(buildSnapshotImage(root, operationLog.lastLsn()), operationLog.lastLsn(), snapshotFile, false);
+                        cout << "[INFO] Tree saved to snapshot '" << snapshotFile << "'.\n";
+                    }
+                    operationLog.close();
+                }
                 cout << "Keluar dari program. Membersihkan memori...\n";
                 deleteTree(root); 
                 break;
             default:
                 cout << "Pilihan tidak valid. Silakan coba lagi.\n";
             }
-    } while (pilihan != 7);
+
+        // log yang sudah besar dipadatkan menjadi checkpoint baru di background
+        if (pilihan != 8 && operationLog.needsCompaction() && !operationLog.failed()) {
+            operationLog.compact(buildSnapshotImage(root, operationLog.lastLsn()), operationLog.lastLsn(), snapshotFile, true);
+        }
+    } while (pilihan != 8);
     
     return 0;
 }
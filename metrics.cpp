@@ -0,0 +1,231 @@
+#include "metrics.h"
+#include "tree.h"
+#include "traversal.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+const char* operationName(Operation op) {
+    static const char* const NAMES[OPERATION_COUNT] = {
+        "addSpeciesPath", "insertSpeciesRecord", "searchNode", "findPath", "updateSpecies", "deleteSpecies",
+        "deleteSpeciesBatch", "deleteTree", "preOrderTraversal", "postOrderTraversal", "levelOrderTraversal",
+        "displayTree",
+    };
+    return NAMES[static_cast<size_t>(op)];
+}
+
+// --- HISTOGRAM ---
+
+/**
+ * @brief Values below 2^SUB_BITS get their own bucket; larger values share a bucket with
+ *        everything that has the same highest bit and the same SUB_BITS bits below it.
+ */
+size_t LatencyHistogram::bucketOf(uint64_t value) {
+    const uint64_t SUB = uint64_t(1) << SUB_BITS;
+    if (value < SUB) return static_cast<size_t>(value);
+
+    unsigned highest = 63;
+    while (!(value >> highest)) --highest;
+    unsigned shift = highest - SUB_BITS;
+    return static_cast<size_t>(((shift + 1) << SUB_BITS) | ((value >> shift) & (SUB - 1)));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+    const uint64_t SUB = uint64_t(1) << SUB_BITS;
+    if (bucket < SUB) return bucket;
+
+    unsigned shift = static_cast<unsigned>(bucket >> SUB_BITS) - 1;
+    uint64_t lower = ((bucket & (SUB - 1)) | SUB) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (std::atomic<uint64_t>& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    uint64_t total = count();
+    if (total == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total)));
+    rank = std::max<uint64_t>(1, std::min(rank, total));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += buckets_[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) return std::min(bucketUpperBound(bucket), max());
+    }
+    return max();
+}
+
+// --- REGISTRY ---
+
+namespace {
+
+struct OperationMetrics {
+    LatencyHistogram latency;   // nanodetik
+    LatencyHistogram visited;   // node yang diperiksa per panggilan
+};
+
+OperationMetrics registry[OPERATION_COUNT];
+
+}
+
+#if TREE_METRICS
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+OperationTimer::OperationTimer(Operation op) : op_(op), startNs_(nowNs()) {}
+
+OperationTimer::~OperationTimer() {
+    OperationMetrics& metrics = registry[static_cast<size_t>(op_)];
+    metrics.latency.record(static_cast<uint64_t>(nowNs() - startNs_));
+    if (hasVisited_) metrics.visited.record(visited_);
+}
+
+#endif
+
+std::vector<OperationStats> collectOperationStats() {
+    std::vector<OperationStats> stats;
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const OperationMetrics& metrics = registry[i];
+        if (metrics.latency.count() == 0) continue;
+
+        OperationStats entry;
+        entry.op = static_cast<Operation>(i);
+        entry.calls = metrics.latency.count();
+        entry.totalNs = metrics.latency.sum();
+        entry.p50Ns = metrics.latency.percentile(50);
+        entry.p90Ns = metrics.latency.percentile(90);
+        entry.p99Ns = metrics.latency.percentile(99);
+        entry.maxNs = metrics.latency.max();
+        entry.tracksVisited = metrics.visited.count() > 0;
+        entry.visitedTotal = metrics.visited.sum();
+        entry.visitedP99 = metrics.visited.percentile(99);
+        entry.visitedMax = metrics.visited.max();
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void resetMetrics() {
+    for (OperationMetrics& metrics : registry) {
+        metrics.latency.reset();
+        metrics.visited.reset();
+    }
+}
+
+// --- MEMORY ---
+
+// bucket array + satu node per entry (pointer next, hash yang di-cache, value)
+template <typename Map>
+static size_t hashMapBytes(const Map& map) {
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*));
+}
+
+/**
+ * @brief Estimates the heap footprint of the whole tree that root belongs to.
+ */
+MemoryStats measureMemory(const Node* root) {
+    MemoryStats stats;
+    if (root == nullptr) return stats;
+    while (root->parent) root = root->parent;
+
+    const TreeContext* ctx = root->ctx;
+    stats.liveNodes = ctx->nodes.liveCount();
+    stats.internedStrings = ctx->strings.size();
+    stats.nodeBytes = ctx->nodes.reservedBytes();
+    stats.stringPoolBytes = ctx->strings.bytes();
+    stats.nodeBytes += ctx->subtreeStats.capacity() * sizeof(SubtreeStats);
+    stats.textBytes = ctx->commonNames.bytes() + ctx->wikiLinks.bytes();
+
+    for (const TraversalEntry& entry : preOrder(const_cast<Node*>(root))) {
+        const Node* node = entry.node;
+        stats.childIndexBytes += node->children.capacity() * sizeof(Node*);
+        if (node->childIndex.wide) stats.childIndexBytes += sizeof(*node->childIndex.wide) + hashMapBytes(*node->childIndex.wide);
+    }
+
+    stats.nameIndexBytes = hashMapBytes(ctx->nameIndex);
+    for (const auto& bucket : ctx->nameIndex) {
+        stats.nameIndexBytes += bucket.second.capacity() * sizeof(Node*);
+    }
+    return stats;
+}
+
+// --- OUTPUT ---
+
+static std::string formatBytes(size_t bytes) {
+    std::ostringstream text;
+    if (bytes >= (size_t(1) << 20)) {
+        text << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / (1 << 20) << " MiB";
+    } else if (bytes >= 1024) {
+        text << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / 1024 << " KiB";
+    } else {
+        text << bytes << " B";
+    }
+    return text.str();
+}
+
+void printMetrics(std::ostream& out, const Node* root) {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "\n--- Operation Metrics ---\n";
+#if TREE_METRICS
+    std::vector<OperationStats> stats = collectOperationStats();
+    if (stats.empty()) {
+        out << "[INFO] No operations recorded yet.\n";
+    } else {
+        out << std::left << std::setw(22) << "operation" << std::right << std::setw(9) << "calls"
+            << std::setw(11) << "avg us" << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+            << std::setw(11) << "p99 us" << std::setw(11) << "max us" << std::setw(13) << "visited/op"
+            << std::setw(12) << "p99 visit" << "\n";
+        out << std::fixed << std::setprecision(2);
+        for (const OperationStats& entry : stats) {
+            out << std::left << std::setw(22) << operationName(entry.op) << std::right << std::setw(9) << entry.calls
+                << std::setw(11) << entry.totalNs / 1e3 / static_cast<double>(entry.calls)
+                << std::setw(11) << entry.p50Ns / 1e3 << std::setw(11) << entry.p90Ns / 1e3
+                << std::setw(11) << entry.p99Ns / 1e3 << std::setw(11) << entry.maxNs / 1e3;
+            if (entry.tracksVisited) {
+                out << std::setw(13) << static_cast<double>(entry.visitedTotal) / static_cast<double>(entry.calls)
+                    << std::setw(12) << entry.visitedP99;
+            } else {
+                out << std::setw(13) << "-" << std::setw(12) << "-";
+            }
+            out << "\n";
+        }
+    }
+#else
+    out << "[INFO] Operation metrics are disabled in this build (TREE_METRICS=0).\n";
+#endif
+
+    MemoryStats memory = measureMemory(root);
+    out << "\n--- Memory ---\n";
+    out << "Live nodes        : " << memory.liveNodes << "\n";
+    out << "Interned strings  : " << memory.internedStrings << "\n";
+    out << "Node arena        : " << formatBytes(memory.nodeBytes) << "\n";
+    out << "String pool       : " << formatBytes(memory.stringPoolBytes) << "\n";
+    out << "Common names/links: " << formatBytes(memory.textBytes) << "\n";
+    out << "Child indexes     : " << formatBytes(memory.childIndexBytes) << "\n";
+    out << "Name index        : " << formatBytes(memory.nameIndexBytes) << "\n";
+    out << "Total (approx.)   : " << formatBytes(memory.totalBytes()) << "\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,119 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Instrumentasi ringan untuk entry point CRUD & traversal di tree.cpp: jumlah panggilan,
+// histogram latency log-linear (ala HDR), jumlah node yang diperiksa per search, dan
+// akuntansi memori tree. Compile dengan -DTREE_METRICS=0 untuk mematikan instrumentasi;
+// makro METRIC_* lalu menjadi kosong sehingga tidak ada overhead sama sekali.
+#ifndef TREE_METRICS
+#define TREE_METRICS 1
+#endif
+
+struct Node;
+
+enum class Operation : uint8_t {
+    AddSpecies, InsertRecord, Search, FindPath, Update, Delete, DeleteBatch, DeleteTree,
+    PreOrder, PostOrder, LevelOrder, Display
+};
+
+const size_t OPERATION_COUNT = static_cast<size_t>(Operation::Display) + 1;
+
+const char* operationName(Operation op);
+
+// Histogram nilai 64-bit dengan 8 sub-bucket per pangkat dua: error relatif <= 12.5%,
+// ukuran tetap, record() cukup satu fetch_add dan aman dipanggil dari banyak thread.
+class LatencyHistogram {
+public:
+    static const unsigned SUB_BITS = 3;
+    static const size_t BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+    LatencyHistogram() { reset(); }
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    // batas atas bucket yang memuat persentil p (0..100), 0 jika kosong
+    uint64_t percentile(double p) const;
+
+    static size_t bucketOf(uint64_t value);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+private:
+    std::atomic<uint64_t> buckets_[BUCKETS];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+// ringkasan satu jenis operasi, untuk ditampilkan atau diekspor
+struct OperationStats {
+    Operation op;
+    uint64_t calls;
+    uint64_t totalNs;
+    uint64_t p50Ns, p90Ns, p99Ns, maxNs;
+    bool tracksVisited;             // operasi ini mencatat jumlah node yang diperiksa
+    uint64_t visitedTotal;
+    uint64_t visitedP99, visitedMax;
+};
+
+// perkiraan memori satu tree (dihitung saat diminta, bukan di jalur operasi)
+struct MemoryStats {
+    size_t liveNodes = 0;
+    size_t internedStrings = 0;
+    size_t nodeBytes = 0;           // chunk arena + kolom agregat subtree
+    size_t stringPoolBytes = 0;     // nama yang di-intern
+    size_t textBytes = 0;           // kolom common name & wiki link (teks pinjaman tidak dihitung)
+    size_t childIndexBytes = 0;     // children vector & child index
+    size_t nameIndexBytes = 0;
+    size_t totalBytes() const { return nodeBytes + stringPoolBytes + textBytes + childIndexBytes + nameIndexBytes; }
+};
+
+// Statistik setiap operasi yang sudah pernah dipanggil (kosong jika TREE_METRICS=0)
+std::vector<OperationStats> collectOperationStats();
+void resetMetrics();
+// Selalu tersedia; O(n) terhadap jumlah node di tree milik root
+MemoryStats measureMemory(const Node* root);
+// Tabel operasi + memori untuk menu "stats"
+void printMetrics(std::ostream& out, const Node* root);
+
+#if TREE_METRICS
+
+// Mencatat latency satu panggilan (dan opsional jumlah node yang diperiksa) saat keluar scope
+class OperationTimer {
+public:
+    explicit OperationTimer(Operation op);
+    ~OperationTimer();
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+
+    void visited(uint64_t nodes) { visited_ = nodes; hasVisited_ = true; }
+
+private:
+    Operation op_;
+    bool hasVisited_ = false;
+    uint64_t visited_ = 0;
+    int64_t startNs_;
+};
+
+#define METRIC_SCOPE(op) OperationTimer metricTimer_(op)
+#define METRIC_VISITED(nodes) metricTimer_.visited(nodes)
+
+#else
+
+#define METRIC_SCOPE(op) ((void)0)
+#define METRIC_VISITED(nodes) ((void)0)
+
+#endif
+
+#endif
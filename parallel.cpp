@@ -0,0 +1,211 @@
+#include "parallel.h"
+
+namespace {
+
+// worker pool yang sedang menjalankan thread ini (nullptr untuk thread di luar pool)
+thread_local ThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+}  // namespace
+
+// --- THREAD POOL ---
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Queues a task: on the caller's own deque when called from a worker of this pool,
+ *        otherwise on the workers in round-robin order.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    size_t index = (currentPool == this) ? currentWorker : nextVictim_.fetch_add(1) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1);
+    {
+        // kunci sebentar supaya notify tidak hilang di antara cek predicate dan wait worker
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+/**
+ * @brief Pops from the back of the own deque, or steals from the front of another one.
+ */
+bool ThreadPool::takeTask(std::function<void()>& task) {
+    if (queued_.load() == 0) return false;
+
+    size_t count = workers_.size();
+    if (currentPool == this) {
+        Worker& own = *workers_[currentWorker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    size_t start = (currentPool == this) ? currentWorker + 1 : nextVictim_.load();
+    for (size_t offset = 0; offset < count; ++offset) {
+        Worker& victim = *workers_[(start + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    if (!takeTask(task)) return false;
+    task();
+    return true;
+}
+
+/**
+ * @brief Sleeps on the same condition variable as idle workers, so both a new task and
+ *        notifyAll() wake the caller; done() is checked under sleepMutex_.
+ */
+void ThreadPool::waitUntil(const std::function<bool()>& done) {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    wake_.wait(lock, [&] { return done() || queued_.load() > 0 || stopping_; });
+}
+
+void ThreadPool::notifyAll() {
+    {
+        // sama seperti submit: notify tidak boleh jatuh di antara cek predicate dan wait
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_all();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (takeTask(task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) break;
+    }
+}
+
+ThreadPool& defaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// --- TASK GROUP ---
+
+void TaskGroup::run(std::function<void()> task) {
+    pending_.fetch_add(1);
+    ThreadPool& pool = pool_;
+    pool_.submit([this, &pool, task = std::move(task)] {
+        task();
+        // setelah fetch_sub grup boleh sudah dihancurkan oleh wait(), jadi hanya pool yang dipakai
+        if (pending_.fetch_sub(1) == 1) pool.notifyAll();
+    });
+}
+
+/**
+ * @brief Waits for all tasks of the group, running queued tasks (of any group) meanwhile
+ *        and sleeping when there is nothing left to run.
+ */
+void TaskGroup::wait() {
+    while (pending_.load() > 0) {
+        if (!pool_.runPendingTask()) pool_.waitUntil([this] { return pending_.load() == 0; });
+    }
+}
+
+// --- ALGORITMA PARALEL PADA TREE ---
+
+/**
+ * @brief Calls visit once for every node; subtrees below options.forkUntil run as separate tasks.
+ */
+void parallelForEachNode(Node* root, const std::function<void(Node*)>& visit, const ParallelOptions& options) {
+    parallelReduce(root, 0, [&visit](Node* node) {
+        visit(node);
+        return 0;
+    }, [](int, int) { return 0; }, options);
+}
+
+/**
+ * @brief Collects matching nodes per subtree and joins the parts in child order,
+ *        so the result equals a sequential pre-order search.
+ */
+std::vector<Node*> parallelFindAll(Node* root, const std::function<bool(const Node*)>& predicate, const ParallelOptions& options) {
+    using Matches = std::vector<Node*>;
+    return parallelReduce(root, Matches(), [&predicate](Node* node) {
+        return predicate(node) ? Matches{node} : Matches();
+    }, [](Matches acc, Matches part) {
+        if (acc.empty()) return part;
+        acc.insert(acc.end(), part.begin(), part.end());
+        return acc;
+    }, options);
+}
+
+static void collectOrders(Node* node, std::vector<std::pair<Node*, size_t>>& orders) {
+    if (node->rank == Rank::Order) {
+        orders.push_back({node, 0});
+        return;
+    }
+    if (node->rank > Rank::Order) return;
+    for (Node* child : node->children) {
+        collectOrders(child, orders);
+    }
+}
+
+/**
+ * @brief Counts species below every Order, one task per Order; the Orders are listed in pre-order.
+ */
+std::vector<std::pair<Node*, size_t>> speciesCountPerOrder(Node* root, const ParallelOptions& options) {
+    std::vector<std::pair<Node*, size_t>> orders;
+    if (root == nullptr) return orders;
+    collectOrders(root, orders);
+
+    ThreadPool& pool = options.pool ? *options.pool : defaultThreadPool();
+    TaskGroup group(pool);
+    for (auto& entry : orders) {
+        group.run([&entry, &options] {
+            entry.second = parallelReduce(entry.first, size_t(0), [](Node* node) {
+                return node->rank == Rank::Species ? size_t(1) : size_t(0);
+            }, [](size_t a, size_t b) { return a + b; }, options);
+        });
+    }
+    group.wait();
+    return orders;
+}
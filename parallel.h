@@ -0,0 +1,134 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "tree.h"
+#include "traversal.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// --- THREAD POOL (work stealing) ---
+// Setiap worker punya deque sendiri: task baru dari worker masuk ke belakang deque-nya
+// dan diambil lagi dari belakang (LIFO, cache-friendly), worker yang menganggur
+// mencuri dari depan deque worker lain.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = 0);   // 0 = std::thread::hardware_concurrency()
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    size_t size() const { return workers_.size(); }
+    void submit(std::function<void()> task);
+    // Menjalankan satu task yang sedang antre di thread pemanggil; false jika tidak ada
+    bool runPendingTask();
+    // Tidur sampai done() benar, ada task baru di antrean, atau pool berhenti
+    void waitUntil(const std::function<bool()>& done);
+    // Membangunkan semua thread yang tidur di waitUntil (dipanggil setelah kondisi done berubah)
+    void notifyAll();
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool takeTask(std::function<void()>& task);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> nextVictim_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+ThreadPool& defaultThreadPool();
+
+// Sekumpulan task fork-join; wait() ikut menjalankan task selama menunggu,
+// jadi task boleh membuat TaskGroup lagi di dalamnya tanpa deadlock. Jika tidak ada
+// task yang bisa diambil, wait() tidur di condition variable pool sampai task terakhir
+// grup selesai atau ada task baru.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup() { wait(); }
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_{0};
+};
+
+// --- ALGORITMA PARALEL PADA TREE ---
+
+struct ParallelOptions {
+    ThreadPool* pool = nullptr;        // nullptr = defaultThreadPool()
+    Rank forkUntil = Rank::Family;     // anak dari node dengan rank <= ini dikerjakan sebagai task terpisah
+    size_t minFanout = 2;              // node dengan anak lebih sedikit dari ini tidak di-fork
+};
+
+namespace detail {
+
+template <typename T, typename Map, typename Combine>
+T reduceSubtree(Node* node, const T& identity, const Map& map, const Combine& combine,
+                const ParallelOptions& options, ThreadPool& pool) {
+    if (node->rank > options.forkUntil || node->children.size() < options.minFanout) {
+        T acc = identity;
+        for (const TraversalEntry& entry : preOrder(node)) {
+            acc = combine(std::move(acc), map(entry.node));
+        }
+        return acc;
+    }
+
+    const std::vector<Node*>& children = node->children;
+    std::vector<T> partial(children.size(), identity);
+    {
+        TaskGroup group(pool);
+        for (size_t i = 1; i < children.size(); ++i) {
+            group.run([&, i] { partial[i] = reduceSubtree(children[i], identity, map, combine, options, pool); });
+        }
+        partial[0] = reduceSubtree(children[0], identity, map, combine, options, pool);
+        group.wait();
+    }
+
+    // digabung dalam urutan pre-order, jadi hasilnya tidak bergantung pada jadwal thread
+    T acc = combine(T(identity), map(node));
+    for (T& value : partial) {
+        acc = combine(std::move(acc), std::move(value));
+    }
+    return acc;
+}
+
+}  // namespace detail
+
+// Fold pre-order yang dibagi per subtree. Untuk combine yang asosiatif hasilnya sama
+// dengan fold sekuensial combine(...combine(combine(identity, map(n1)), map(n2))...).
+// map dan combine dipanggil dari beberapa thread sekaligus.
+template <typename T, typename Map, typename Combine>
+T parallelReduce(Node* root, T identity, Map map, Combine combine, const ParallelOptions& options = ParallelOptions()) {
+    if (root == nullptr) return identity;
+    ThreadPool& pool = options.pool ? *options.pool : defaultThreadPool();
+    return detail::reduceSubtree(root, identity, map, combine, options, pool);
+}
+
+// visit dipanggil tepat sekali untuk setiap node, dari beberapa thread dan tanpa urutan tertentu
+void parallelForEachNode(Node* root, const std::function<void(Node*)>& visit, const ParallelOptions& options = ParallelOptions());
+// Semua node yang memenuhi predicate, dalam urutan pre-order (sama dengan hasil sekuensial)
+std::vector<Node*> parallelFindAll(Node* root, const std::function<bool(const Node*)>& predicate, const ParallelOptions& options = ParallelOptions());
+// Jumlah species di bawah setiap Order, dalam urutan Order di tree
+std::vector<std::pair<Node*, size_t>> speciesCountPerOrder(Node* root, const ParallelOptions& options = ParallelOptions());
+
+#endif
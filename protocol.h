@@ -0,0 +1,67 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// --- PROTOKOL SERVER (Unix domain socket) ---
+// Setiap pesan adalah satu frame: uint32_t panjang payload (little-endian) lalu payload.
+//   request  = opcode (1 byte) + argumen teks, beberapa argumen dipisah tab
+//   response = status (1 byte) + isi teks
+// Satu koneksi boleh mengirim banyak request tanpa menunggu (pipelining); response selalu
+// dikirim dalam urutan request di koneksi itu. Header ini tidak bergantung pada tree,
+// jadi client cukup meng-include file ini.
+//
+//   Search   name                                      Ok: Rank<TAB>name<TAB>common<TAB>wikiLink
+//   Add      Class<TAB>Order<TAB>Family<TAB>Genus<TAB>Species<TAB>Common[<TAB>WikiLink]
+//                                                      Ok: added|updated|unchanged, Invalid: rejected
+//   Update   name<TAB>Common[<TAB>WikiLink]            Ok: updated (tanpa wiki link, link lama dipertahankan)
+//   Delete   name                                      Ok: jumlah species yang dihapus
+//   Subtree  [name]                                    Ok: satu baris Rank<TAB>name<TAB>common per node (pre-order);
+//                                                      tanpa nama = seluruh tree
+//   Stats    -                                         Ok: tabel metrik (sama dengan menu Stats)
+// NotFound dipakai jika nama tidak ada (atau bukan species untuk Update), Invalid untuk
+// argumen yang salah. Unavailable menggantikan Ok untuk Add/Update/Delete yang tidak bisa
+// dicatat ke operation log; server lalu berhenti. Frame lebih besar dari MAX_FRAME_SIZE menutup koneksi.
+
+const uint32_t MAX_FRAME_SIZE = 1u << 20;
+const size_t FRAME_HEADER_SIZE = sizeof(uint32_t);
+
+enum class RequestOp : uint8_t {
+    Search = 1, Add = 2, Update = 3, Delete = 4, Subtree = 5, Stats = 6
+};
+
+enum class ResponseStatus : uint8_t {
+    Ok = 0, NotFound = 1, Invalid = 2, Unavailable = 3
+};
+
+inline bool isReadOnly(RequestOp op) {
+    return op == RequestOp::Search || op == RequestOp::Subtree || op == RequestOp::Stats;
+}
+
+/**
+ * @brief Appends one frame (length, code byte, body) to out.
+ */
+inline void appendFrame(std::string& out, uint8_t code, std::string_view body) {
+    uint32_t length = static_cast<uint32_t>(body.size() + 1);
+    for (size_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+        out.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+    out.push_back(static_cast<char>(code));
+    out.append(body.data(), body.size());
+}
+
+/**
+ * @brief Reads the payload length at the start of data; data must hold FRAME_HEADER_SIZE bytes.
+ */
+inline uint32_t frameLength(const char* data) {
+    uint32_t length = 0;
+    for (size_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+        length |= static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return length;
+}
+
+#endif
@@ -0,0 +1,263 @@
+#include "query.h"
+#include <algorithm>
+#include <unordered_set>
+
+/**
+ * @brief Iterative glob match: on a mismatch after a '*', the star absorbs one more character.
+ */
+bool globMatchFolded(std::string_view pattern, std::string_view text) {
+    const size_t NONE = std::string_view::npos;
+    size_t p = 0, t = 0, star = NONE, mark = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = t;
+        } else if (p < pattern.size() && (pattern[p] == '?' || foldChar(pattern[p]) == foldChar(text[t]))) {
+            ++p;
+            ++t;
+        } else if (star != NONE) {
+            p = star + 1;
+            t = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+// --- CURSOR ---
+
+/**
+ * @brief Splits the pattern into segments; false (with error_ set) on empty segments or a second "**".
+ */
+bool QueryCursor::compile(std::string_view pattern) {
+    if (pattern.empty()) {
+        error_ = "empty pattern";
+        return false;
+    }
+
+    bool anyDepthSeen = false;
+    size_t pos = 0;
+    while (true) {
+        size_t slash = pattern.find('/', pos);
+        std::string_view text = pattern.substr(pos, slash == std::string_view::npos ? std::string_view::npos : slash - pos);
+        if (text.empty()) {
+            error_ = "empty path segment";
+            return false;
+        }
+
+        SegmentKind kind = SegmentKind::Exact;
+        if (text == "**") {
+            if (anyDepthSeen) {
+                error_ = "only one '**' is allowed per pattern";
+                return false;
+            }
+            anyDepthSeen = true;
+            kind = SegmentKind::AnyDepth;
+        } else if (text == "*") {
+            kind = SegmentKind::Any;
+        } else if (text.find_first_of("*?") != std::string_view::npos) {
+            kind = SegmentKind::Glob;
+        }
+        segments_.push_back({kind, std::string(text)});
+
+        if (slash == std::string_view::npos) break;
+        pos = slash + 1;
+    }
+    return true;
+}
+
+bool QueryCursor::canLeadToResult(const Node* node) const {
+    // rank sama dengan kedalaman, jadi di bawah rank filter tidak ada hasil lagi
+    return !filter_.filterRank || node->rank <= filter_.rank;
+}
+
+bool QueryCursor::accepts(const Node* node) const {
+    if (filter_.filterRank && node->rank != filter_.rank) return false;
+    if (filter_.wikiLink == QueryFilter::Link::Present && nodeWikiLink(node).empty()) return false;
+    if (filter_.wikiLink == QueryFilter::Link::Missing && !nodeWikiLink(node).empty()) return false;
+    if (!filter_.commonNamePattern.empty() && !globMatchFolded(filter_.commonNamePattern, nodeCommonName(node))) return false;
+    return true;
+}
+
+/**
+ * @brief Adds the zero-level step of "**": a node that still has "**" pending has also
+ *        already matched it, so the segment after it is pending too.
+ */
+uint64_t QueryCursor::closure(uint64_t mask) const {
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        if ((mask >> i & 1) && segments_[i].kind == SegmentKind::AnyDepth) mask |= uint64_t(1) << (i + 1);
+    }
+    return mask;
+}
+
+/**
+ * @brief Positions reached at child from the positions reached at its parent.
+ */
+uint64_t QueryCursor::advance(uint64_t mask, const Node* child) const {
+    uint64_t next = 0;
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        if ((mask >> i & 1) == 0) continue;
+        const Segment& segment = segments_[i];
+        bool match = false;
+        switch (segment.kind) {
+            case SegmentKind::AnyDepth: next |= uint64_t(1) << i; break;
+            case SegmentKind::Any:      match = true; break;
+            case SegmentKind::Exact:    match = equalsFolded(segment.text, child->name.str()); break;
+            case SegmentKind::Glob:     match = globMatchFolded(segment.text, child->name.str()); break;
+        }
+        if (match) next |= uint64_t(1) << (i + 1);
+    }
+    if (nestedStarts_ && startSet_.count(child)) next |= uint64_t(1) << 1;
+    return closure(next);
+}
+
+/**
+ * @brief Seeds the stack. A leading exact name is looked up in the name index, so the walk
+ *        starts at the named nodes instead of at the root.
+ */
+void QueryCursor::start(Node* root, bool anchored) {
+    root_ = root;
+    // setiap segmen selain "**" memakan satu level, jadi pola sepanjang ini tidak punya hasil
+    if (root == nullptr || segments_.size() >= 64) return;
+
+    const Segment& first = segments_.front();
+    if (anchored || first.kind != SegmentKind::Exact) {
+        stack_.push_back({nullptr, closure(1), 0, false});
+        return;
+    }
+
+    auto it = root->ctx->nameIndex.find(first.text);
+    if (it == root->ctx->nameIndex.end()) return;
+
+    std::vector<Node*> starts;
+    for (Node* node : it->second) {
+        ++visited_;
+        if (!equalsFolded(node->name.str(), first.text) || !canLeadToResult(node)) continue;
+        const Node* ancestor = node;
+        while (ancestor && ancestor != root) ancestor = ancestor->parent;
+        if (ancestor) starts.push_back(node);
+    }
+
+    // start di bawah start lain tidak dijalankan terpisah: walk dari start teratas menandainya
+    // saat lewat, supaya hasil keduanya keluar dalam satu pre-order tanpa duplikat
+    if (starts.size() > 1) {
+        startSet_.insert(starts.begin(), starts.end());
+        size_t before = starts.size();
+        starts.erase(std::remove_if(starts.begin(), starts.end(), [&](const Node* node) {
+            for (const Node* ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+                if (startSet_.count(ancestor)) return true;
+            }
+            return false;
+        }), starts.end());
+        nestedStarts_ = starts.size() != before;
+        if (!nestedStarts_) {
+            startSet_.clear();
+        } else {
+            // node di antara start teratas dan start di bawahnya tetap dikunjungi walau
+            // polanya sudah tidak cocok di situ
+            for (const Node* node : startSet_) {
+                for (const Node* ancestor = node->parent; ancestor && !startSet_.count(ancestor); ancestor = ancestor->parent) {
+                    if (!waypoints_.insert(ancestor).second) break;
+                }
+            }
+        }
+    }
+
+    // dibalik supaya start pertama dalam pre-order diproses lebih dulu
+    std::sort(starts.begin(), starts.end(), [](const Node* a, const Node* b) { return precedesInPreorder(b, a); });
+    for (Node* node : starts) {
+        stack_.push_back({node, closure(uint64_t(1) << 1), 0, false});
+    }
+}
+
+/**
+ * @brief Advances the pre-order walk until the next node that matches every segment and the
+ *        filter. Each frame carries every pattern position reached at its node, so "**" and
+ *        the segments after it are matched in one walk and results come out in pre-order.
+ */
+Node* QueryCursor::next() {
+    const uint64_t done = uint64_t(1) << segments_.size();
+    while (!stack_.empty()) {
+        Frame& frame = stack_.back();
+        Node* parent = frame.node;
+        if (!frame.entered) {
+            frame.entered = true;
+            if (parent && (frame.mask & done) && accepts(parent)) return parent;
+        }
+
+        // frame dengan node nullptr adalah induk virtual yang anaknya hanya root
+        size_t childCount = parent ? parent->children.size() : 1;
+        uint64_t pending = frame.mask & ~done;
+
+        // satu nama persis yang tersisa: cukup lewat child index, tanpa memeriksa setiap anak
+        bool single = pending != 0 && (pending & (pending - 1)) == 0;
+        size_t position = 0;
+        while (single && (pending >> position & 1) == 0) ++position;
+        if (single && !nestedStarts_ && segments_[position].kind == SegmentKind::Exact) {
+            Node* child = nullptr;
+            if (frame.nextChild == 0) {
+                ++visited_;
+                const std::string& name = segments_[position].text;
+                child = parent ? parent->childIndex.find(parent->children, name)
+                               : (equalsFolded(root_->name.str(), name) ? root_ : nullptr);
+            }
+            frame.nextChild = childCount;
+            if (child && canLeadToResult(child)) {
+                stack_.push_back({child, closure(uint64_t(1) << (position + 1)), 0, false});
+            } else {
+                stack_.pop_back();
+            }
+            continue;
+        }
+
+        Node* match = nullptr;
+        uint64_t matchMask = 0;
+        bool scan = pending != 0 || (nestedStarts_ && (startSet_.count(parent) || waypoints_.count(parent)));
+        while (match == nullptr && scan && frame.nextChild < childCount) {
+            Node* child = parent ? parent->children[frame.nextChild] : root_;
+            ++frame.nextChild;
+            ++visited_;
+            if (!canLeadToResult(child)) continue;
+            matchMask = advance(frame.mask, child);
+            if (matchMask != 0 || (nestedStarts_ && waypoints_.count(child))) match = child;
+        }
+        if (match) {
+            stack_.push_back({match, matchMask, 0, false});
+        } else {
+            stack_.pop_back();
+        }
+    }
+    return nullptr;
+}
+
+// --- API ---
+
+QueryCursor queryPath(Node* root, std::string_view pattern, const QueryFilter& filter) {
+    QueryCursor cursor;
+    cursor.filter_ = filter;
+    bool anchored = !pattern.empty() && pattern.front() == '/';
+    if (anchored) pattern.remove_prefix(1);
+    if (cursor.compile(pattern)) {
+        cursor.start(root, anchored);
+    }
+    return cursor;
+}
+
+QueryCursor queryRank(Node* root, const std::string& ancestorName, Rank rank, const QueryFilter& filter) {
+    QueryCursor cursor;
+    cursor.filter_ = filter;
+    cursor.filter_.filterRank = true;
+    cursor.filter_.rank = rank;
+    if (ancestorName.empty()) {
+        cursor.error_ = "empty ancestor name";
+        return cursor;
+    }
+    // "<nama>/*/**": minimal satu level di bawah ancestor, nama tidak diparse sebagai pola
+    cursor.segments_.push_back({QueryCursor::SegmentKind::Exact, ancestorName});
+    cursor.segments_.push_back({QueryCursor::SegmentKind::Any, "*"});
+    cursor.segments_.push_back({QueryCursor::SegmentKind::AnyDepth, "**"});
+    cursor.start(root, false);
+    return cursor;
+}
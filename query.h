@@ -0,0 +1,122 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include "tree.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// --- QUERY ENGINE ---
+// Pola path dipisah '/', setiap segmen dicocokkan dengan satu level (case-insensitive):
+//   Lamnidae     nama persis, dicari lewat child index (atau name index untuk segmen pertama)
+//   Carchar*     glob dengan '*' dan '?', membandingkan setiap anak
+//   *            node apa saja di level itu
+//   **           nol level atau lebih (paling banyak satu per pola)
+// Segmen pertama yang berupa nama persis boleh menunjuk node di level mana pun
+// ("Carcharhinidae/*" mencari Carcharhinidae lewat name index). Awali pola dengan '/'
+// agar segmen pertama harus cocok dengan root tree ("/Chondrichthyes/Lamniformes/*/*/*").
+
+// filter tambahan yang dicek pada setiap node hasil
+struct QueryFilter {
+    enum class Link : uint8_t { Any, Present, Missing };
+
+    bool filterRank = false;           // true = hanya node dengan rank di bawah
+    Rank rank = Rank::Species;
+    std::string commonNamePattern;     // glob case-insensitive untuk commonName; kosong = semua
+    Link wikiLink = Link::Any;
+
+    static QueryFilter ofRank(Rank rank) {
+        QueryFilter filter;
+        filter.filterRank = true;
+        filter.rank = rank;
+        return filter;
+    }
+};
+
+// '*' dan '?' dengan perbandingan case-insensitive (fold.h), tanpa alokasi
+bool globMatchFolded(std::string_view pattern, std::string_view text);
+
+// Hasil query dibaca satu per satu dengan DFS ber-stack eksplisit; hasil tidak pernah
+// dikumpulkan. Urutan hasil mengikuti pre-order. Tree tidak boleh diubah selama iterasi.
+class QueryCursor {
+public:
+    QueryCursor() = default;
+
+    // node hasil berikutnya, nullptr jika sudah habis
+    Node* next();
+    // pesan kesalahan pola; kosong jika pola valid
+    const std::string& error() const { return error_; }
+    size_t visited() const { return visited_; }   // node yang sudah diperiksa sejauh ini
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Node*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Node* const*;
+        using reference = Node* const&;
+
+        iterator() = default;
+        explicit iterator(QueryCursor* cursor) : cursor_(cursor), node_(cursor->next()) {}
+        reference operator*() const { return node_; }
+        iterator& operator++() { node_ = cursor_->next(); return *this; }
+        bool operator==(const iterator& other) const { return node_ == other.node_; }
+        bool operator!=(const iterator& other) const { return node_ != other.node_; }
+
+    private:
+        QueryCursor* cursor_ = nullptr;
+        Node* node_ = nullptr;
+    };
+
+    // for (Node* node : queryPath(root, "Lamniformes/*/*")) { ... }; hanya bisa diiterasi sekali
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+private:
+    friend QueryCursor queryPath(Node* root, std::string_view pattern, const QueryFilter& filter);
+    friend QueryCursor queryRank(Node* root, const std::string& ancestorName, Rank rank, const QueryFilter& filter);
+
+    enum class SegmentKind : uint8_t { Exact, Glob, Any, AnyDepth };
+    struct Segment {
+        SegmentKind kind;
+        std::string text;
+    };
+    // bit i di mask: node (nullptr = induk virtual dari root) sudah cocok dengan segments_[0, i);
+    // bit segments_.size() berarti node itu sendiri hasil. "**" membuat lebih dari satu bit aktif.
+    struct Frame {
+        Node* node;
+        uint64_t mask;
+        size_t nextChild;
+        bool entered;        // node sudah diperiksa sebagai hasil
+    };
+
+    bool compile(std::string_view pattern);
+    void start(Node* root, bool anchored);
+    bool accepts(const Node* node) const;
+    bool canLeadToResult(const Node* node) const;
+    uint64_t closure(uint64_t mask) const;
+    uint64_t advance(uint64_t mask, const Node* child) const;
+
+    Node* root_ = nullptr;
+    std::vector<Segment> segments_;
+    QueryFilter filter_;
+    std::vector<Frame> stack_;
+    std::unordered_set<const Node*> startSet_;  // hanya terisi jika ada start di bawah start lain
+    std::unordered_set<const Node*> waypoints_; // ancestor start itu di bawah start teratas
+    bool nestedStarts_ = false;
+    std::string error_;
+    size_t visited_ = 0;
+};
+
+// Query pola path dari root (lihat di atas). Pola yang tidak valid menghasilkan cursor
+// kosong dengan error() terisi.
+QueryCursor queryPath(Node* root, std::string_view pattern, const QueryFilter& filter = QueryFilter());
+// Semua node dengan rank tertentu di bawah node bernama ancestorName, mis. semua Genus di
+// bawah Carcharhinidae. Hanya turun sampai level rank tersebut.
+QueryCursor queryRank(Node* root, const std::string& ancestorName, Rank rank, const QueryFilter& filter = QueryFilter());
+
+#endif
@@ -0,0 +1,599 @@
+#include "server.h"
+#include "metrics.h"
+#include "parallel.h"
+#include "snapshot.h"
+#include "traversal.h"
+#include "wal.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// grup read-only sebesar ini atau lebih dibagi ke thread pool
+static const size_t PARALLEL_READ_GROUP = 256;
+
+// --- EKSEKUSI REQUEST ---
+
+static void splitFields(std::string_view args, std::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t pos = 0;
+    while (true) {
+        size_t tab = args.find('\t', pos);
+        fields.push_back(args.substr(pos, tab == std::string_view::npos ? std::string_view::npos : tab - pos));
+        if (tab == std::string_view::npos) break;
+        pos = tab + 1;
+    }
+}
+
+static void appendStatus(std::string& out, ResponseStatus status, std::string_view body) {
+    appendFrame(out, static_cast<uint8_t>(status), body);
+}
+
+/**
+ * @brief Answers one Search, Subtree or Stats request; safe to run concurrently with other reads.
+ */
+static void executeRead(Node* root, RequestOp op, std::string_view args, std::string& out, std::string& scratch) {
+    scratch.clear();
+    switch (op) {
+        case RequestOp::Search: {
+            Node* found = searchNode(root, std::string(args));
+            if (found == nullptr) {
+                appendStatus(out, ResponseStatus::NotFound, args);
+                return;
+            }
+            scratch.append(rankName(found->rank)).append(1, '\t').append(found->name.str()).append(1, '\t');
+            scratch.append(nodeCommonName(found)).append(1, '\t').append(nodeWikiLink(found));
+        } break;
+        case RequestOp::Subtree: {
+            Node* start = args.empty() ? root : searchNode(root, std::string(args));
+            if (start == nullptr) {
+                appendStatus(out, ResponseStatus::NotFound, args);
+                return;
+            }
+            for (const TraversalEntry& entry : preOrder(start)) {
+                scratch.append(rankName(entry.node->rank)).append(1, '\t').append(entry.node->name.str());
+                scratch.append(1, '\t').append(nodeCommonName(entry.node)).append(1, '\n');
+            }
+        } break;
+        case RequestOp::Stats: {
+            std::ostringstream table;
+            printMetrics(table, root);
+            scratch = table.str();
+        } break;
+        default:
+            appendStatus(out, ResponseStatus::Invalid, "unknown request");
+            return;
+    }
+    appendStatus(out, ResponseStatus::Ok, scratch);
+}
+
+/**
+ * @brief Applies one Add, Update or Delete and logs it when the tree actually changed.
+ * @return LSN of the log record, 0 if nothing was logged.
+ */
+static uint64_t executeWrite(Node*& root, RequestOp op, std::string_view args, std::string& out,
+                             OperationLog* log, std::vector<std::string_view>& fields) {
+    bool logging = log && log->isOpen();
+    uint64_t lsn = 0;
+    splitFields(args, fields);
+
+    switch (op) {
+        case RequestOp::Add: {
+            if (fields.size() < REQUIRED_TOTAL_INPUTS || fields.size() > REQUIRED_TOTAL_INPUTS + 1) {
+                appendStatus(out, ResponseStatus::Invalid, "expected Class..Species, common name and optional wiki link");
+                break;
+            }
+            if (std::any_of(fields.begin(), fields.begin() + REQUIRED_TOTAL_INPUTS, [](std::string_view field) { return field.empty(); })) {
+                appendStatus(out, ResponseStatus::Invalid, "empty taxonomic or common name");
+                break;
+            }
+            std::vector<std::string_view> path(fields.begin(), fields.begin() + REQUIRED_TAX_LEVELS);
+            std::string_view commonName = fields[REQUIRED_TAX_LEVELS];
+            std::string_view wikiLink = fields.size() > REQUIRED_TOTAL_INPUTS ? fields[REQUIRED_TOTAL_INPUTS] : std::string_view();
+
+            InsertResult result = insertSpeciesRecord(root, path, commonName, wikiLink);
+            if (logging && (result == InsertResult::Added || result == InsertResult::Updated)) {
+                lsn = log->logAdd(std::vector<std::string>(path.begin(), path.end()), std::string(commonName), std::string(wikiLink));
+            }
+            switch (result) {
+                case InsertResult::Added:     appendStatus(out, ResponseStatus::Ok, "added"); break;
+                case InsertResult::Updated:   appendStatus(out, ResponseStatus::Ok, "updated"); break;
+                case InsertResult::Unchanged: appendStatus(out, ResponseStatus::Ok, "unchanged"); break;
+                case InsertResult::Rejected:  appendStatus(out, ResponseStatus::Invalid, "rejected"); break;
+            }
+        } break;
+        case RequestOp::Update: {
+            if (fields.size() < 2 || fields.size() > 3 || fields[0].empty() || fields[1].empty()) {
+                appendStatus(out, ResponseStatus::Invalid, "expected name, common name and optional wiki link");
+                break;
+            }
+            Node* species = searchNode(root, std::string(fields[0]));
+            if (species == nullptr || species->rank != Rank::Species) {
+                appendStatus(out, ResponseStatus::NotFound, fields[0]);
+                break;
+            }
+            // tanpa kolom wiki link, link yang lama dipertahankan
+            std::string commonName(fields[1]);
+            std::string wikiLink(fields.size() > 2 ? fields[2] : nodeWikiLink(species));
+            if (logging) lsn = log->logUpdate(nodePath(species), commonName, wikiLink);
+            updateSpeciesRecord(species, commonName, wikiLink);
+            appendStatus(out, ResponseStatus::Ok, "updated");
+        } break;
+        case RequestOp::Delete: {
+            if (args.empty()) {
+                appendStatus(out, ResponseStatus::Invalid, "missing name");
+                break;
+            }
+            std::string name(args);
+            size_t removed = deleteSpeciesRecord(root, name);
+            if (removed == 0) {
+                appendStatus(out, ResponseStatus::NotFound, args);
+                break;
+            }
+            if (logging) lsn = log->logDelete(name);
+            appendStatus(out, ResponseStatus::Ok, std::to_string(removed));
+        } break;
+        default:
+            appendStatus(out, ResponseStatus::Invalid, "unknown request");
+            break;
+    }
+    return lsn;
+}
+
+#ifdef __linux__
+
+// --- EVENT LOOP ---
+
+static const size_t READ_SIZE = 64 * 1024;
+// koneksi dengan output sebanyak ini yang belum terkirim tidak dibaca dulu (backpressure)
+static const size_t MAX_PENDING_OUTPUT = 8u << 20;
+static const int MAX_EVENTS = 256;
+
+// self-pipe: handler sinyal hanya menulis satu byte, event loop bangun lewat epoll
+static int stopPipe[2] = {-1, -1};
+
+static void onStopSignal(int) {
+    char byte = 1;
+    ssize_t ignored = write(stopPipe[1], &byte, 1);
+    (void)ignored;
+}
+
+struct Connection {
+    int fd = -1;
+    std::string input;          // byte yang sudah dibaca, frame lengkap dipotong setiap putaran
+    size_t parsed = 0;          // awal frame berikutnya di input
+    std::string output;         // response yang belum terkirim
+    size_t sent = 0;
+    uint32_t events = 0;        // event yang terdaftar di epoll
+    bool peerClosed = false;    // client sudah menutup sisi tulisnya
+    bool broken = false;        // error socket atau frame tidak valid; ditutup di akhir putaran
+    bool queued = false;        // sudah ada di daftar ready putaran ini
+
+    size_t pendingOutput() const { return output.size() - sent; }
+};
+
+struct PendingRequest {
+    Connection* conn;
+    RequestOp op;
+    std::string_view args;      // menunjuk ke conn->input, valid sampai akhir putaran
+};
+
+static void setInterest(int epoll, Connection& conn) {
+    uint32_t events = 0;
+    if (!conn.peerClosed && conn.pendingOutput() < MAX_PENDING_OUTPUT) events |= EPOLLIN | EPOLLRDHUP;
+    if (conn.pendingOutput() > 0) events |= EPOLLOUT;
+    if (events == conn.events) return;
+
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = conn.fd;
+    epoll_ctl(epoll, EPOLL_CTL_MOD, conn.fd, &event);
+    conn.events = events;
+}
+
+/**
+ * @brief Reads until the socket would block (or the input buffer is full); a zero-length
+ *        read marks the peer as closed.
+ */
+static void readAvailable(Connection& conn) {
+    while (conn.input.size() < MAX_PENDING_OUTPUT) {
+        size_t old = conn.input.size();
+        conn.input.resize(old + READ_SIZE);
+        ssize_t got = read(conn.fd, &conn.input[old], READ_SIZE);
+        conn.input.resize(old + (got > 0 ? static_cast<size_t>(got) : 0));
+        if (got > 0) continue;
+        if (got == 0) {
+            conn.peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            conn.broken = true;
+        }
+        return;
+    }
+}
+
+static void writePending(Connection& conn) {
+    while (conn.pendingOutput() > 0) {
+        ssize_t put = send(conn.fd, conn.output.data() + conn.sent, conn.pendingOutput(), MSG_NOSIGNAL);
+        if (put > 0) {
+            conn.sent += static_cast<size_t>(put);
+        } else if (put < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (put < 0 && errno != EAGAIN && errno != EWOULDBLOCK) conn.broken = true;
+            break;
+        }
+    }
+    if (conn.sent == conn.output.size()) {
+        conn.output.clear();
+        conn.sent = 0;
+    }
+}
+
+static bool hasCompleteFrame(const Connection& conn) {
+    if (conn.input.size() < FRAME_HEADER_SIZE) return false;
+    uint32_t length = frameLength(conn.input.data());
+    return length == 0 || length > MAX_FRAME_SIZE || conn.input.size() - FRAME_HEADER_SIZE >= length;
+}
+
+/**
+ * @brief Cuts the complete frames of one connection into requests, oldest first.
+ * @return false if a frame is empty or larger than MAX_FRAME_SIZE.
+ */
+static bool parseFrames(Connection& conn, std::vector<PendingRequest>& pending) {
+    const std::string& input = conn.input;
+    while (input.size() - conn.parsed >= FRAME_HEADER_SIZE) {
+        uint32_t length = frameLength(input.data() + conn.parsed);
+        if (length == 0 || length > MAX_FRAME_SIZE) return false;
+        if (input.size() - conn.parsed - FRAME_HEADER_SIZE < length) break;
+
+        const char* payload = input.data() + conn.parsed + FRAME_HEADER_SIZE;
+        pending.push_back({&conn, static_cast<RequestOp>(payload[0]), std::string_view(payload + 1, length - 1)});
+        conn.parsed += FRAME_HEADER_SIZE + length;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens the listening socket. A stale socket file is replaced, a live one is refused.
+ */
+static int openListener(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "[ERROR] Socket path must be 1.." << sizeof(address.sun_path) - 1 << " bytes long.\n";
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            std::cerr << "[ERROR] '" << path << "' exists and is not a socket.\n";
+            return -1;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = probe >= 0 && connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) close(probe);
+        if (live) {
+            std::cerr << "[ERROR] Another server is already listening on '" << path << "'.\n";
+            return -1;
+        }
+        unlink(path.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "[ERROR] Cannot listen on '" << path << "': " << std::strerror(errno) << "\n";
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Answers the consecutive Delete requests [begin, end) with one deleteSpeciesBatch.
+ *        Responses and log records are the same as executing them one by one.
+ * @return LSN of the last log record, 0 if nothing was logged.
+ */
+static uint64_t executeDeleteRun(Node* root, const std::vector<PendingRequest>& pending, size_t begin, size_t end,
+                                 std::vector<std::string>& responses, OperationLog* log) {
+    bool logging = log && log->isOpen();
+    uint64_t lsn = 0;
+    std::vector<std::string> names;
+    std::vector<size_t> requests;   // index request untuk setiap nama
+    for (size_t i = begin; i < end; ++i) {
+        if (pending[i].args.empty()) {
+            appendStatus(responses[i], ResponseStatus::Invalid, "missing name");
+            continue;
+        }
+        names.emplace_back(pending[i].args);
+        requests.push_back(i);
+    }
+
+    std::vector<size_t> removed;
+    deleteSpeciesBatch(root, names, &removed);
+    for (size_t k = 0; k < names.size(); ++k) {
+        std::string& out = responses[requests[k]];
+        if (removed[k] == 0) {
+            appendStatus(out, ResponseStatus::NotFound, names[k]);
+            continue;
+        }
+        if (logging) lsn = log->logDelete(names[k]);
+        appendStatus(out, ResponseStatus::Ok, std::to_string(removed[k]));
+    }
+    return lsn;
+}
+
+/**
+ * @brief Executes one round of requests in arrival order: runs of reads as one (parallel)
+ *        group, runs of deletes as one deleteSpeciesBatch, other writes one by one.
+ *        responses[i] receives the frame for pending[i].
+ * @return LSN of the last logged change, 0 if none.
+ */
+static uint64_t executeRound(Node*& root, const std::vector<PendingRequest>& pending, std::vector<std::string>& responses,
+                             const ServerOptions& options, ThreadPool& pool, ServerStats& stats) {
+    uint64_t lastLsn = 0;
+    std::vector<std::string_view> fields;
+    std::string scratch;
+
+    size_t i = 0;
+    while (i < pending.size()) {
+        if (pending[i].op == RequestOp::Delete) {
+            size_t end = i + 1;
+            while (end < pending.size() && pending[end].op == RequestOp::Delete) ++end;
+            if (end - i > 1) {
+                uint64_t lsn = executeDeleteRun(root, pending, i, end, responses, options.log);
+                if (lsn) lastLsn = lsn;
+                stats.writes += end - i;
+                i = end;
+                continue;
+            }
+        }
+        if (!isReadOnly(pending[i].op)) {
+            uint64_t lsn = executeWrite(root, pending[i].op, pending[i].args, responses[i], options.log, fields);
+            if (lsn) lastLsn = lsn;
+            ++stats.writes;
+            ++i;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < pending.size() && isReadOnly(pending[end].op)) ++end;
+        size_t count = end - i;
+        stats.reads += count;
+        if (count < PARALLEL_READ_GROUP || pool.size() < 2) {
+            for (; i < end; ++i) executeRead(root, pending[i].op, pending[i].args, responses[i], scratch);
+            continue;
+        }
+
+        size_t tasks = std::min(pool.size() * 4, count / (PARALLEL_READ_GROUP / 2));
+        size_t perTask = (count + tasks - 1) / tasks;
+        {
+            TaskGroup group(pool);
+            for (size_t t = 0; t < tasks; ++t) {
+                group.run([&, t] {
+                    std::string localScratch;
+                    size_t first = i + t * perTask, last = std::min(end, first + perTask);
+                    for (size_t k = first; k < last; ++k) {
+                        executeRead(root, pending[k].op, pending[k].args, responses[k], localScratch);
+                    }
+                });
+            }
+            group.wait();
+        }
+        i = end;
+    }
+    return lastLsn;
+}
+
+/**
+ * @brief Epoll event loop; see server.h.
+ */
+bool runServer(Node*& root, const ServerOptions& options, ServerStats* stats) {
+    ServerStats local;
+    ServerStats& result = stats ? *stats : local;
+    result = ServerStats();
+    auto started = std::chrono::steady_clock::now();
+
+    int listener = openListener(options.socketPath);
+    if (listener < 0) return false;
+
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0 || pipe2(stopPipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+        std::cerr << "[ERROR] Cannot set up the event loop: " << std::strerror(errno) << "\n";
+        if (epoll >= 0) close(epoll);
+        close(listener);
+        unlink(options.socketPath.c_str());
+        return false;
+    }
+
+    struct sigaction stopAction{}, oldInt{}, oldTerm{};
+    stopAction.sa_handler = onStopSignal;
+    sigemptyset(&stopAction.sa_mask);
+    sigaction(SIGINT, &stopAction, &oldInt);
+    sigaction(SIGTERM, &stopAction, &oldTerm);
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listener;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &event);
+    event.data.fd = stopPipe[0];
+    epoll_ctl(epoll, EPOLL_CTL_ADD, stopPipe[0], &event);
+
+    std::cout << "[INFO] Serving on '" << options.socketPath << "' (Ctrl+C to stop).\n" << std::flush;
+
+    ThreadPool& pool = options.pool ? *options.pool : defaultThreadPool();
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::vector<Connection*> ready;
+    std::vector<Connection*> carried;   // masih punya frame lengkap yang tertahan backpressure
+    std::vector<PendingRequest> pending;
+    std::vector<std::string> responses;
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+    bool logFailed = false;
+
+    while (running) {
+        int count = epoll_wait(epoll, events, MAX_EVENTS, carried.empty() ? -1 : 0);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[ERROR] epoll_wait failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        ready.clear();
+        auto markReady = [&ready](Connection& conn) {
+            if (!conn.queued) {
+                conn.queued = true;
+                ready.push_back(&conn);
+            }
+        };
+        for (Connection* conn : carried) markReady(*conn);
+        carried.clear();
+
+        for (int e = 0; e < count; ++e) {
+            int fd = events[e].data.fd;
+            if (fd == stopPipe[0]) {
+                running = false;
+                continue;
+            }
+            if (fd == listener) {
+                int client;
+                while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    if (connections.size() >= options.maxConnections) {
+                        close(client);
+                        continue;
+                    }
+                    auto conn = std::make_unique<Connection>();
+                    conn->fd = client;
+                    conn->events = EPOLLIN | EPOLLRDHUP;
+                    epoll_event added{};
+                    added.events = conn->events;
+                    added.data.fd = client;
+                    epoll_ctl(epoll, EPOLL_CTL_ADD, client, &added);
+                    connections.emplace(client, std::move(conn));
+                    ++result.connections;
+                }
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& conn = *it->second;
+            if (events[e].events & EPOLLOUT) writePending(conn);
+            if (events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) readAvailable(conn);
+            markReady(conn);
+        }
+
+        // frame lengkap dari semua koneksi yang siap, urut per koneksi
+        pending.clear();
+        for (Connection* conn : ready) {
+            if (conn->broken || conn->pendingOutput() >= MAX_PENDING_OUTPUT) continue;
+            if (!parseFrames(*conn, pending)) {
+                conn->broken = true;
+                ++result.protocolErrors;
+            }
+        }
+        // request dari koneksi yang rusak tidak dijalankan
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [](const PendingRequest& request) { return request.conn->broken; }),
+                      pending.end());
+
+        if (!pending.empty()) {
+            if (responses.size() < pending.size()) responses.resize(pending.size());
+            for (size_t i = 0; i < pending.size(); ++i) responses[i].clear();
+
+            uint64_t lastLsn = executeRound(root, pending, responses, options, pool, result);
+            result.requests += pending.size();
+            ++result.batches;
+
+            // group commit: satu tunggu per putaran, response baru dikirim sesudah durable
+            if (options.log && options.log->isOpen()) {
+                if (!options.log->waitDurable(lastLsn)) {
+                    // perubahan putaran ini tidak durable: ditolak, lalu server berhenti supaya
+                    // tidak ada request lain yang melihat tree yang sudah menyimpang dari log
+                    for (size_t i = 0; i < pending.size(); ++i) {
+                        if (isReadOnly(pending[i].op) || responses[i].size() <= FRAME_HEADER_SIZE ||
+                            responses[i][FRAME_HEADER_SIZE] != static_cast<char>(ResponseStatus::Ok)) {
+                            continue;
+                        }
+                        responses[i].clear();
+                        appendStatus(responses[i], ResponseStatus::Unavailable, "operation log write failed");
+                    }
+                    logFailed = true;
+                    running = false;
+                } else if (options.log->needsCompaction()) {
+                    uint64_t checkpoint = options.log->lastLsn();
+                    options.log->compact(buildSnapshotImage(root, checkpoint), checkpoint, options.snapshotFile, true);
+                }
+            }
+            for (size_t i = 0; i < pending.size(); ++i) {
+                pending[i].conn->output += responses[i];
+            }
+        }
+
+        for (Connection* conn : ready) {
+            conn->queued = false;
+            conn->input.erase(0, conn->parsed);
+            conn->parsed = 0;
+            if (!conn->broken) writePending(*conn);
+
+            bool more = conn->pendingOutput() < MAX_PENDING_OUTPUT && hasCompleteFrame(*conn);
+            // sisa input sesudah client menutup hanya bisa berupa frame yang terpotong
+            if (conn->broken || (conn->peerClosed && conn->pendingOutput() == 0 && !more)) {
+                epoll_ctl(epoll, EPOLL_CTL_DEL, conn->fd, nullptr);
+                close(conn->fd);
+                connections.erase(conn->fd);
+                continue;
+            }
+            if (more) carried.push_back(conn);
+            setInterest(epoll, *conn);
+        }
+    }
+
+    for (auto& entry : connections) {
+        close(entry.first);
+    }
+    sigaction(SIGINT, &oldInt, nullptr);
+    sigaction(SIGTERM, &oldTerm, nullptr);
+    close(stopPipe[0]);
+    close(stopPipe[1]);
+    stopPipe[0] = stopPipe[1] = -1;
+    close(epoll);
+    close(listener);
+    unlink(options.socketPath.c_str());
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (logFailed) {
+        std::cerr << "[ERROR] The operation log could not be written; the server stopped.\n";
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool runServer(Node*& root, const ServerOptions& options, ServerStats* stats) {
+    (void)root;
+    (void)options;
+    if (stats) *stats = ServerStats();
+    std::cerr << "[ERROR] Server mode needs Linux (epoll); use --batch on this platform.\n";
+    return false;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "tree.h"
+#include "protocol.h"
+#include <cstdint>
+#include <string>
+
+class OperationLog;
+class ThreadPool;
+
+// --- SERVER MODE ---
+// Melayani protokol di protocol.h lewat Unix domain socket dengan satu event loop epoll
+// non-blocking (hanya Linux). Setiap putaran loop mengumpulkan semua frame lengkap dari
+// semua koneksi yang siap: request read-only yang berurutan dijalankan sebagai satu batch
+// (paralel di pool bila cukup besar), perubahan diterapkan di thread loop sesuai urutan
+// datangnya, lalu satu group commit ke log sebelum response putaran itu dikirim.
+struct ServerOptions {
+    std::string socketPath;
+    OperationLog* log = nullptr;        // jika terbuka, setiap perubahan dicatat
+    std::string snapshotFile;           // tujuan checkpoint saat log perlu dipadatkan
+    ThreadPool* pool = nullptr;         // untuk batch read-only; nullptr = defaultThreadPool()
+    size_t maxConnections = 1024;
+};
+
+// ringkasan satu kali server berjalan
+struct ServerStats {
+    uint64_t connections = 0;
+    uint64_t requests = 0;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t batches = 0;           // putaran loop yang menjalankan minimal satu request
+    uint64_t protocolErrors = 0;    // koneksi yang ditutup karena frame tidak valid
+    double seconds = 0.0;
+};
+
+// Berjalan sampai SIGINT/SIGTERM. false jika socket tidak bisa dibuka, platform tidak didukung,
+// atau operation log gagal ditulis (server berhenti sesudah menolak perubahan putaran itu).
+bool runServer(Node*& root, const ServerOptions& options, ServerStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,452 @@
+#include "snapshot.h"
+#include "traversal.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <queue>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = {'S', 'H', 'R', 'K', 'T', 'A', 'X', '\0'};
+static const uint32_t SNAPSHOT_ENDIAN_CHECK = 0x01020304u;
+
+/**
+ * @brief FNV-1a over the lowercased bytes; stable across runs so it can live in the file.
+ */
+static uint32_t foldedHash(std::string_view str) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : str) {
+        hash ^= static_cast<unsigned char>(foldChar(static_cast<char>(c)));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint64_t alignTo8(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+// --- WRITER ---
+
+/**
+ * @brief Serializes a tree (or subtree) into one contiguous snapshot image.
+ */
+std::vector<char> buildSnapshotImage(const Node* root, uint64_t checkpointLsn) {
+    // urutan pre-order, tanpa rekursi
+    std::vector<const Node*> order;
+    if (root) {
+        std::vector<const Node*> stack = {root};
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            order.push_back(node);
+            for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+                stack.push_back(*it);
+            }
+        }
+    }
+    uint32_t count = static_cast<uint32_t>(order.size());
+
+    std::vector<uint32_t> indexById(root ? root->ctx->nodes.idLimit() : 0, SNAPSHOT_NONE);
+    for (uint32_t i = 0; i < count; ++i) {
+        indexById[order[i]->id] = i;
+    }
+
+    // string blob; offset 0 adalah string kosong
+    std::string blob(sizeof(uint32_t), '\0');
+    auto appendString = [&](std::string_view str) -> uint32_t {
+        if (str.empty()) return 0;
+        uint32_t offset = static_cast<uint32_t>(blob.size());
+        uint32_t length = static_cast<uint32_t>(str.size());
+        blob.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        blob.append(str);
+        return offset;
+    };
+    // nama sudah di-intern, jadi cukup dedup per pointer; common name/wiki link hampir selalu unik
+    std::unordered_map<const std::string*, uint32_t> nameOffsets;
+    nameOffsets.reserve(count);
+    auto addName = [&](const InternedName& name) -> uint32_t {
+        auto inserted = nameOffsets.emplace(&name.str(), 0);
+        if (inserted.second) inserted.first->second = appendString(name.str());
+        return inserted.first->second;
+    };
+
+    std::vector<SnapshotNode> nodes(count);
+    std::vector<uint32_t> children;
+    children.reserve(count);
+    size_t hashEntries = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const Node* node = order[i];
+        SnapshotNode& out = nodes[i];
+        std::memset(&out, 0, sizeof(out));
+        out.name = addName(node->name);
+        std::string_view commonName = nodeCommonName(node);
+        out.commonName = appendString(commonName);
+        out.wikiLink = appendString(nodeWikiLink(node));
+        out.parent = (i == 0) ? SNAPSHOT_NONE : indexById[node->parent->id];
+        out.rank = static_cast<uint8_t>(node->rank);
+        out.firstChild = static_cast<uint32_t>(children.size());
+        out.childCount = static_cast<uint32_t>(node->children.size());
+        for (const Node* child : node->children) {
+            children.push_back(indexById[child->id]);
+        }
+        hashEntries += commonName.empty() ? 1 : 2;
+    }
+
+    // ukuran subtree dihitung dari belakang: anak selalu sesudah parent-nya
+    std::vector<uint32_t> subtreeSize(count, 1);
+    for (uint32_t i = count; i-- > 1;) {
+        subtreeSize[nodes[i].parent] += subtreeSize[i];
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        nodes[i].subtreeEnd = i + subtreeSize[i];
+    }
+
+    uint32_t buckets = 16;
+    while (buckets < hashEntries * 2) buckets <<= 1;
+    std::vector<uint32_t> table(buckets, 0);
+    auto addKey = [&](std::string_view key, uint32_t index) {
+        uint32_t slot = foldedHash(key) & (buckets - 1);
+        while (table[slot] != 0) slot = (slot + 1) & (buckets - 1);
+        table[slot] = index + 1;
+    };
+    for (uint32_t i = 0; i < count; ++i) {
+        const Node* node = order[i];
+        addKey(node->name.str(), i);
+        std::string_view commonName = nodeCommonName(node);
+        if (!commonName.empty() && !equalsFolded(commonName, node->name.str())) {
+            addKey(commonName, i);
+        }
+    }
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.endianCheck = SNAPSHOT_ENDIAN_CHECK;
+    header.nodeCount = count;
+    header.hashBuckets = buckets;
+    header.nodesOffset = alignTo8(sizeof(SnapshotHeader));
+    header.childrenOffset = alignTo8(header.nodesOffset + nodes.size() * sizeof(SnapshotNode));
+    header.hashOffset = alignTo8(header.childrenOffset + children.size() * sizeof(uint32_t));
+    header.stringsOffset = alignTo8(header.hashOffset + table.size() * sizeof(uint32_t));
+    header.stringsSize = blob.size();
+    header.fileSize = header.stringsOffset + blob.size();
+    header.checkpointLsn = checkpointLsn;
+
+    std::vector<char> image(header.fileSize, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (!nodes.empty()) std::memcpy(image.data() + header.nodesOffset, nodes.data(), nodes.size() * sizeof(SnapshotNode));
+    if (!children.empty()) std::memcpy(image.data() + header.childrenOffset, children.data(), children.size() * sizeof(uint32_t));
+    std::memcpy(image.data() + header.hashOffset, table.data(), table.size() * sizeof(uint32_t));
+    std::memcpy(image.data() + header.stringsOffset, blob.data(), blob.size());
+    return image;
+}
+
+/**
+ * @brief Writes the image next to the target, syncs it and renames it into place.
+ */
+bool writeSnapshotImage(const std::vector<char>& image, const std::string& filename) {
+    std::string tempName = filename + ".tmp";
+
+    std::FILE* file = std::fopen(tempName.c_str(), "wb");
+    if (!file) {
+        std::cerr << "[ERROR] Cannot write snapshot '" << tempName << "'.\n";
+        return false;
+    }
+    bool ok = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    ok = (std::fflush(file) == 0) && ok;
+#ifdef _WIN32
+    ok = ok && (_commit(_fileno(file)) == 0);
+#else
+    ok = ok && (fsync(fileno(file)) == 0);
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+
+#ifdef _WIN32
+    ok = ok && MoveFileExA(tempName.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    ok = ok && std::rename(tempName.c_str(), filename.c_str()) == 0;
+#endif
+    if (!ok) {
+        std::cerr << "[ERROR] Failed to save snapshot '" << filename << "'.\n";
+        std::remove(tempName.c_str());
+    }
+    return ok;
+}
+
+bool saveSnapshot(const Node* root, const std::string& filename, uint64_t checkpointLsn) {
+    return writeSnapshotImage(buildSnapshotImage(root, checkpointLsn), filename);
+}
+
+// --- READER ---
+
+bool SnapshotView::open(const std::string& filename) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const char* data = mapping ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    // view tetap hidup setelah handle ditutup
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    if (!data) return false;
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return false;
+    const char* data = static_cast<const char*>(addr);
+#endif
+
+    data_ = data;
+    size_ = size;
+    mapped_ = true;
+    if (!validate(size)) {
+        std::cerr << "[ERROR] '" << filename << "' is not a valid version " << SNAPSHOT_VERSION << " snapshot.\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotView::attach(const char* data, size_t size) {
+    close();
+    data_ = data;
+    size_ = size;
+    if (!validate(size)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SnapshotView::close() {
+    if (mapped_ && data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    header_ = nullptr;
+    nodes_ = nullptr;
+    children_ = nullptr;
+    hash_ = nullptr;
+}
+
+/**
+ * @brief Checks the header and every node reference once, so later accesses need no bounds
+ *        checks. The tree shape is checked too (pre-order layout, children lists that agree
+ *        with parent/subtreeEnd, rank == depth), because loadSnapshotTree and the traversals
+ *        rely on it.
+ */
+bool SnapshotView::validate(size_t size) {
+    if (size < sizeof(SnapshotHeader)) return false;
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data_);
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->endianCheck != SNAPSHOT_ENDIAN_CHECK ||
+        header->fileSize != size) {
+        return false;
+    }
+
+    // setiap offset dicek terhadap ukuran file dulu, jadi penjumlahan di bawah tidak bisa overflow
+    uint64_t count = header->nodeCount;
+    uint64_t childCount = count ? count - 1 : 0;
+    auto section = [&](uint64_t offset, uint64_t alignment) {
+        return offset <= size && offset % alignment == 0;
+    };
+    if (!section(header->nodesOffset, alignof(SnapshotNode)) || header->nodesOffset < sizeof(SnapshotHeader) ||
+        !section(header->childrenOffset, alignof(uint32_t)) || !section(header->hashOffset, alignof(uint32_t)) ||
+        !section(header->stringsOffset, 1) || header->stringsSize > size - header->stringsOffset) {
+        return false;
+    }
+    if (header->hashBuckets == 0 || (header->hashBuckets & (header->hashBuckets - 1)) != 0 ||
+        header->nodesOffset + count * sizeof(SnapshotNode) > header->childrenOffset ||
+        header->childrenOffset + childCount * sizeof(uint32_t) > header->hashOffset ||
+        header->hashOffset + uint64_t(header->hashBuckets) * sizeof(uint32_t) > header->stringsOffset ||
+        header->stringsOffset + header->stringsSize != size ||
+        header->stringsSize < sizeof(uint32_t)) {
+        return false;
+    }
+
+    const SnapshotNode* nodes = reinterpret_cast<const SnapshotNode*>(data_ + header->nodesOffset);
+    const uint32_t* children = reinterpret_cast<const uint32_t*>(data_ + header->childrenOffset);
+    const uint32_t* hash = reinterpret_cast<const uint32_t*>(data_ + header->hashOffset);
+
+    auto validString = [&](uint32_t offset) {
+        if (uint64_t(offset) + sizeof(uint32_t) > header->stringsSize) return false;
+        uint32_t length;
+        std::memcpy(&length, data_ + header->stringsOffset + offset, sizeof(length));
+        return uint64_t(offset) + sizeof(uint32_t) + length <= header->stringsSize;
+    };
+    for (uint64_t i = 0; i < count; ++i) {
+        const SnapshotNode& node = nodes[i];
+        if (!validString(node.name) || !validString(node.commonName) || !validString(node.wikiLink) ||
+            node.rank >= REQUIRED_TAX_LEVELS || node.subtreeEnd <= i || node.subtreeEnd > count ||
+            (i == 0) != (node.parent == SNAPSHOT_NONE) || (i > 0 && node.parent >= i) ||
+            uint64_t(node.firstChild) + node.childCount > childCount) {
+            return false;
+        }
+    }
+    if (count > 0 && (nodes[0].rank != 0 || nodes[0].subtreeEnd != count)) return false;
+
+    // anak node i harus tepat subtree-subtree berurutan yang mengisi [i + 1, subtreeEnd)
+    for (uint64_t i = 0; i < count; ++i) {
+        const SnapshotNode& node = nodes[i];
+        uint64_t next = i + 1;
+        for (uint32_t k = 0; k < node.childCount; ++k) {
+            uint32_t child = children[node.firstChild + k];
+            if (child >= count || child != next || nodes[child].parent != i || nodes[child].rank != node.rank + 1) return false;
+            next = nodes[child].subtreeEnd;
+        }
+        if (next != node.subtreeEnd) return false;
+    }
+
+    // search berhenti di slot kosong, jadi harus ada minimal satu
+    bool emptySlot = false;
+    for (uint32_t i = 0; i < header->hashBuckets; ++i) {
+        if (hash[i] > count) return false;
+        emptySlot = emptySlot || hash[i] == 0;
+    }
+    if (!emptySlot) return false;
+
+    header_ = header;
+    nodes_ = nodes;
+    children_ = children;
+    hash_ = hash;
+    return true;
+}
+
+std::string_view SnapshotView::string(uint32_t offset) const {
+    const char* base = data_ + header_->stringsOffset + offset;
+    uint32_t length;
+    std::memcpy(&length, base, sizeof(length));
+    return std::string_view(base + sizeof(length), length);
+}
+
+uint32_t SnapshotView::search(std::string_view name) const {
+    if (!header_ || header_->nodeCount == 0) return SNAPSHOT_NONE;
+
+    uint32_t mask = header_->hashBuckets - 1;
+    uint32_t best = SNAPSHOT_NONE;
+    for (uint32_t slot = foldedHash(name) & mask; hash_[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t index = hash_[slot] - 1;
+        if (index < best && (equalsFolded(this->name(index), name) || equalsFolded(commonName(index), name))) {
+            best = index;
+        }
+    }
+    return best;
+}
+
+// --- REBUILD ---
+
+/**
+ * @brief Rebuilds a mutable tree from a snapshot; parents always precede children in the file.
+ */
+static Node* buildTree(const SnapshotView& view, TextStorage storage) {
+    uint32_t count = view.nodeCount();
+    std::vector<Node*> created(count, nullptr);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t parent = view.node(i).parent;
+        created[i] = appendChild(parent == SNAPSHOT_NONE ? nullptr : created[parent], std::string(view.name(i)),
+                                 view.rank(i), view.commonName(i), view.wikiLink(i), storage);
+    }
+    return count ? created[0] : nullptr;
+}
+
+Node* loadSnapshotTree(const SnapshotView& view) {
+    return buildTree(view, TextStorage::Copy);
+}
+
+Node* loadSnapshotTree(std::shared_ptr<const SnapshotView> view) {
+    Node* root = buildTree(*view, TextStorage::Borrow);
+    if (root) root->ctx->metadataBacking = std::move(view);
+    return root;
+}
+
+// --- TRAVERSAL LANGSUNG DARI SNAPSHOT ---
+
+static void writeEntry(BufferedWriter& out, const SnapshotView& view, uint32_t index) {
+    writeListingLine(out, view.rank(index), view.name(index), view.commonName(index));
+}
+
+void displayTree(const SnapshotView& view) {
+    BufferedWriter out(std::cout);
+    // stack berisi subtreeEnd dari ancestor yang masih terbuka
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i < view.nodeCount(); ++i) {
+        while (!open.empty() && open.back() <= i) open.pop_back();
+        writeDisplayLine(out, open.size(), view.rank(i), view.name(i), view.commonName(i), !view.wikiLink(i).empty());
+        open.push_back(view.node(i).subtreeEnd);
+    }
+}
+
+void preOrderTraversal(const SnapshotView& view) {
+    BufferedWriter out(std::cout);
+    for (uint32_t i = 0; i < view.nodeCount(); ++i) {
+        writeEntry(out, view, i);
+    }
+}
+
+void postOrderTraversal(const SnapshotView& view) {
+    BufferedWriter out(std::cout);
+    // node dicetak saat seluruh subtree-nya sudah lewat
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i < view.nodeCount(); ++i) {
+        while (!open.empty() && view.node(open.back()).subtreeEnd <= i) {
+            writeEntry(out, view, open.back());
+            open.pop_back();
+        }
+        open.push_back(i);
+    }
+    while (!open.empty()) {
+        writeEntry(out, view, open.back());
+        open.pop_back();
+    }
+}
+
+void levelOrderTraversal(const SnapshotView& view) {
+    if (view.nodeCount() == 0) return;
+
+    BufferedWriter out(std::cout);
+    std::queue<uint32_t> q;
+    q.push(0);
+    while (!q.empty()) {
+        uint32_t current = q.front();
+        q.pop();
+        writeEntry(out, view, current);
+        for (const uint32_t* child = view.childrenBegin(current); child != view.childrenEnd(current); ++child) {
+            q.push(*child);
+        }
+    }
+}
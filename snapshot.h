@@ -0,0 +1,106 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "tree.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Format snapshot biner (little-endian), semua offset relatif ke awal file:
+//   SnapshotHeader
+//   SnapshotNode[nodeCount]      node dalam urutan pre-order, subtree i = [i, subtreeEnd)
+//   uint32_t[nodeCount - 1]      index anak; anak node i = children[firstChild, firstChild + childCount)
+//   uint32_t[hashBuckets]        hash table nama & common name (lowercase) -> index node + 1, 0 = kosong
+//   string blob                  setiap string: uint32_t panjang lalu byte-nya; offset 0 = string kosong
+const uint32_t SNAPSHOT_VERSION = 2;   // v2: checkpointLsn untuk operation log
+const uint32_t SNAPSHOT_NONE = 0xFFFFFFFFu;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianCheck;
+    uint32_t nodeCount;
+    uint32_t hashBuckets;     // pangkat dua
+    uint64_t nodesOffset;
+    uint64_t childrenOffset;
+    uint64_t hashOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;
+    uint64_t checkpointLsn;   // record operation log sampai LSN ini sudah termasuk di snapshot
+};
+
+struct SnapshotNode {
+    uint32_t name;            // offset ke string blob
+    uint32_t commonName;
+    uint32_t wikiLink;
+    uint32_t parent;          // SNAPSHOT_NONE untuk root
+    uint32_t subtreeEnd;
+    uint32_t firstChild;
+    uint32_t childCount;
+    uint8_t rank;
+    uint8_t reserved[3];
+};
+
+// Tampilan read-only atas snapshot yang di-mmap (atau buffer di memori).
+// Search dan traversal dilayani langsung dari mapping tanpa deserialisasi.
+class SnapshotView {
+public:
+    SnapshotView() = default;
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+    ~SnapshotView() { close(); }
+
+    bool open(const std::string& filename);
+    // Memakai image yang sudah ada di memori (mis. hasil buildSnapshotImage), tidak disalin
+    bool attach(const char* data, size_t size);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    uint64_t checkpointLsn() const { return header_ ? header_->checkpointLsn : 0; }
+    uint32_t nodeCount() const { return header_ ? header_->nodeCount : 0; }
+    const SnapshotNode& node(uint32_t index) const { return nodes_[index]; }
+    std::string_view name(uint32_t index) const { return string(nodes_[index].name); }
+    std::string_view commonName(uint32_t index) const { return string(nodes_[index].commonName); }
+    std::string_view wikiLink(uint32_t index) const { return string(nodes_[index].wikiLink); }
+    Rank rank(uint32_t index) const { return static_cast<Rank>(nodes_[index].rank); }
+    const uint32_t* childrenBegin(uint32_t index) const { return children_ + nodes_[index].firstChild; }
+    const uint32_t* childrenEnd(uint32_t index) const { return childrenBegin(index) + nodes_[index].childCount; }
+
+    // Sama seperti searchNode: nama taksonomi atau common name, case-insensitive,
+    // node pertama dalam pre-order jika ada beberapa. SNAPSHOT_NONE jika tidak ada.
+    uint32_t search(std::string_view name) const;
+
+private:
+    std::string_view string(uint32_t offset) const;
+    bool validate(size_t size);
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    const SnapshotHeader* header_ = nullptr;
+    const SnapshotNode* nodes_ = nullptr;
+    const uint32_t* children_ = nullptr;
+    const uint32_t* hash_ = nullptr;
+};
+
+// --- FUNGSI SNAPSHOT ---
+std::vector<char> buildSnapshotImage(const Node* root, uint64_t checkpointLsn = 0);
+// Ditulis ke file sementara lalu di-rename, jadi snapshot lama tetap utuh jika gagal
+bool writeSnapshotImage(const std::vector<char>& image, const std::string& filename);
+bool saveSnapshot(const Node* root, const std::string& filename, uint64_t checkpointLsn = 0);
+// Membangun ulang tree yang bisa diubah (CRUD) dari snapshot
+Node* loadSnapshotTree(const SnapshotView& view);
+// Sama, tetapi common name & wiki link tidak disalin: kolom metadata menunjuk langsung ke
+// mapping (halaman file baru dibaca saat ditampilkan) dan tree ikut memiliki view-nya
+Node* loadSnapshotTree(std::shared_ptr<const SnapshotView> view);
+
+// Traversal yang dilayani langsung dari snapshot, format output sama dengan versi Node*
+void displayTree(const SnapshotView& view);
+void preOrderTraversal(const SnapshotView& view);
+void postOrderTraversal(const SnapshotView& view);
+void levelOrderTraversal(const SnapshotView& view);
+
+#endif
@@ -0,0 +1,97 @@
+// Test batch.cpp: delete berurutan lewat deleteSpeciesBatch harus sama dengan satu per satu
+#include "test_util.h"
+#include "batch.h"
+#include "wal.h"
+#include <fstream>
+#include <sstream>
+
+static std::string runScript(Node*& root, const TempDir& dir, const std::string& script, OperationLog* log = nullptr) {
+    std::string file = dir.file("commands.txt");
+    {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out << script;
+    }
+    std::FILE* input = std::fopen(file.c_str(), "rb");
+    std::ostringstream output;
+    BatchOptions options;
+    options.log = log;
+    options.snapshotFile = dir.file("tree.snap");
+    CHECK(runBatch(root, input, output, options));
+    std::fclose(input);
+    return output.str();
+}
+
+// add acak lalu delete-delete berurutan; separator disisipkan di antara delete jika diberikan
+static void buildScripts(std::mt19937& rng, std::string& adds, std::vector<std::string>& deletes) {
+    for (int i = 0; i < 300; ++i) {
+        adds += "add\tChondrichthyes";
+        for (int level = 1; level < 5; ++level) adds += "\tn" + std::to_string(rng() % 5);
+        adds += "\tShark " + std::to_string(rng() % 10) + "\n";
+    }
+    for (int i = 0; i < 40; ++i) {
+        deletes.push_back((rng() % 2) ? "n" + std::to_string(rng() % 5) : "Shark " + std::to_string(rng() % 10));
+    }
+}
+
+TEST(deleteRunsMatchSingleDeletes) {
+    TempDir dir("batch_delete");
+    std::mt19937 rng(12);
+    std::string adds;
+    std::vector<std::string> deletes;
+    buildScripts(rng, adds, deletes);
+
+    std::string run, separated;
+    for (const std::string& name : deletes) {
+        run += "delete " + name + "\n";
+        // search di antara delete memutus run, jadi setiap delete berjalan sendiri
+        separated += "delete " + name + "\nsearch zz-separator\n";
+    }
+
+    Node* batched = nullptr;
+    Node* single = nullptr;
+    runScript(batched, dir, adds);
+    runScript(single, dir, adds);
+    std::string batchedOutput = runScript(batched, dir, run);
+    std::string singleOutput = runScript(single, dir, separated);
+
+    std::string filtered;
+    std::istringstream lines(singleOutput);
+    for (std::string line; std::getline(lines, line);) {
+        if (line != "not found: zz-separator") filtered += line + "\n";
+    }
+    CHECK_EQ(batchedOutput, filtered);
+    CHECK_EQ(contentHash(batched), contentHash(single));
+    CHECK(checkSubtreeStats(batched));
+    deleteTree(batched);
+    deleteTree(single);
+}
+
+TEST(deleteRunsReplayFromLog) {
+    TempDir dir("batch_replay");
+    std::mt19937 rng(13);
+    std::string adds;
+    std::vector<std::string> deletes;
+    buildScripts(rng, adds, deletes);
+    std::string script = adds;
+    for (const std::string& name : deletes) script += "delete " + name + "\n";
+
+    std::string logFile = dir.file("tree.snap.wal");
+    Node* root = nullptr;
+    {
+        OperationLog log;
+        CHECK(log.open(logFile, 0));
+        runScript(root, dir, script, &log);
+    }
+
+    // log mencatat setiap delete yang menghapus sesuatu, jadi replay sampai ke tree yang sama
+    Node* recovered = nullptr;
+    uint64_t lastLsn = 0;
+    CHECK(recoverTree(dir.file("tree.snap"), logFile, recovered, lastLsn));
+    CHECK(recovered != nullptr && root != nullptr && contentHash(recovered) == contentHash(root));
+    deleteTree(recovered);
+    deleteTree(root);
+}
+
+int main() {
+    return runTests();
+}
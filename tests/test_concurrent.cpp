@@ -0,0 +1,233 @@
+// Test concurrent.cpp: reader tidak pernah melihat versi setengah jadi, versi lama di-free,
+// dan publish hanya menyalin path yang berubah
+#include "test_util.h"
+#include "concurrent.h"
+#include "traversal.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static std::vector<std::string> versionPath(const VersionNode* node) {
+    std::vector<std::string> path;
+    for (const VersionPath* link = node ? node->path.get() : nullptr; link; link = link->parent.get()) path.push_back(link->name);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+static LogRecord addRecord(const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink = "") {
+    return LogRecord{0, LogOp::Add, path, commonName, wikiLink, ""};
+}
+
+// --- VERSI SEBAGAI GENERASI ---
+// Batch k menambah species "s<k>_<i>", mengubah common name species batch k-1 menjadi
+// "gen <k>" dan menghapus species batch k-2. Versi dengan k batch jadi punya tepat species
+// batch k dan k-1, semuanya dengan common name "gen <k>"; campuran dua batch berarti torn.
+
+static const size_t PER_BATCH = 40;
+
+static std::string speciesName(size_t batch, size_t i) {
+    return "s" + std::to_string(batch) + "_" + std::to_string(i);
+}
+
+static std::vector<std::string> speciesPathOf(size_t batch, size_t i) {
+    return {"Chondrichthyes", "O" + std::to_string(i % 3), "F" + std::to_string(i % 5), "G" + std::to_string((i + batch) % 7),
+            speciesName(batch, i)};
+}
+
+static std::vector<LogRecord> generation(size_t batch) {
+    std::vector<LogRecord> records;
+    std::string commonName = "gen " + std::to_string(batch);
+    for (size_t i = 0; i < PER_BATCH; ++i) records.push_back(addRecord(speciesPathOf(batch, i), commonName));
+    if (batch >= 1) {
+        for (size_t i = 0; i < PER_BATCH; ++i) {
+            records.push_back(LogRecord{0, LogOp::Update, speciesPathOf(batch - 1, i), commonName, "", ""});
+        }
+    }
+    if (batch >= 2) {
+        for (size_t i = 0; i < PER_BATCH; ++i) records.push_back(LogRecord{0, LogOp::Delete, {}, "", "", speciesName(batch - 2, i)});
+    }
+    return records;
+}
+
+// agregat setiap node sama dengan jumlah species yang benar-benar ada di bawahnya
+static size_t walkSpecies(const VersionNode* node, const std::string& commonName, bool& consistent) {
+    if (node->rank == Rank::Species) {
+        consistent = consistent && node->children.empty() && node->speciesCount == 1 && node->commonName == commonName;
+        return 1;
+    }
+    size_t total = 0;
+    for (const auto& child : node->children) total += walkSpecies(child.get(), commonName, consistent);
+    consistent = consistent && node->speciesCount == total && node->childByName.size() == node->children.size();
+    return total;
+}
+
+/**
+ * @brief Checks that a version is exactly the state after some number of whole batches.
+ */
+static bool versionIsWhole(const TreeVersion& version, std::mt19937& rng, bool fullWalk) {
+    size_t batch = static_cast<size_t>(version.number - 1);
+    std::string commonName = "gen " + std::to_string(batch);
+    size_t expected = batch == 0 ? PER_BATCH : 2 * PER_BATCH;
+    if (version.speciesCount() != expected) return false;
+
+    size_t i = rng() % PER_BATCH;
+    const VersionNode* current = version.search(speciesName(batch, i));
+    if (current == nullptr || current->commonName != commonName || versionPath(current) != speciesPathOf(batch, i)) return false;
+    if (batch >= 1) {
+        const VersionNode* previous = version.search(speciesName(batch - 1, i));
+        if (previous == nullptr || previous->commonName != commonName) return false;
+    }
+    if (batch >= 2 && version.search(speciesName(batch - 2, i)) != nullptr) return false;
+    if (version.search(speciesName(batch + 1, i)) != nullptr) return false;
+
+    if (!fullWalk) return true;
+    bool consistent = true;
+    return walkSpecies(version.root.get(), commonName, consistent) == expected && consistent;
+}
+
+static Node* firstGeneration() {
+    Node* root = nullptr;
+    for (const LogRecord& record : generation(0)) applyLogRecord(root, record);
+    return root;
+}
+
+TEST(readersNeverSeeTornVersions) {
+    ConcurrentTree tree(firstGeneration());
+    const size_t BATCHES = 300;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> failures{0};
+    std::atomic<size_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < 4; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937 rng(r);
+            uint64_t last = 0;
+            size_t count = 0;
+            while (!done.load()) {
+                ConcurrentTree::ReadGuard guard = tree.read();
+                // nomor versi tidak pernah mundur untuk satu reader
+                if (guard.number() < last || !versionIsWhole(guard.version(), rng, count % 16 == 0)) failures.fetch_add(1);
+                last = guard.number();
+                // sebagian guard ditahan lebih lama supaya writer harus menunda reclaim
+                if (count % 64 == 0) std::this_thread::yield();
+                ++count;
+            }
+            reads.fetch_add(count);
+        });
+    }
+
+    for (size_t batch = 1; batch <= BATCHES; ++batch) {
+        CHECK_EQ(tree.apply(generation(batch)), uint64_t(batch + 1));
+    }
+    done.store(true);
+    for (std::thread& reader : readers) reader.join();
+
+    CHECK_EQ(failures.load(), size_t(0));
+    CHECK(reads.load() > 0);
+    std::mt19937 rng(99);
+    CHECK(versionIsWhole(tree.read().version(), rng, true));
+
+    // tanpa reader aktif, publish berikutnya mem-free semua versi lama
+    tree.apply({});
+    CHECK_EQ(tree.retiredCount(), size_t(0));
+}
+
+TEST(retiredVersionsAreFreedAfterLastReader) {
+    ConcurrentTree tree(firstGeneration());
+    std::weak_ptr<const VersionNode> oldRoot;
+    std::weak_ptr<const VersionNode> oldSpecies;
+    {
+        ConcurrentTree::ReadGuard guard = tree.read();
+        oldRoot = guard->root;
+        const VersionNode* species = guard->findPath(speciesPathOf(0, 0));
+        CHECK(species != nullptr);
+        // weak_ptr ke node species lewat anak Genus-nya
+        std::vector<std::string> genusPath = speciesPathOf(0, 0);
+        genusPath.pop_back();
+        const VersionNode* genus = guard->findPath(genusPath);
+        uint32_t position = 0;
+        CHECK(genus != nullptr && genus->child(speciesName(0, 0), &position) == species);
+        if (genus) oldSpecies = genus->children[position];
+
+        for (size_t batch = 1; batch <= 4; ++batch) tree.apply(generation(batch));
+        // versi yang dipegang tetap utuh walaupun species-nya sudah dihapus di versi terbaru
+        CHECK(tree.retiredCount() > 0);
+        CHECK(guard->search(speciesName(0, 0)) == species);
+        CHECK(species->commonName == "gen 0");
+        CHECK(tree.read()->search(speciesName(0, 0)) == nullptr);
+        CHECK(!oldRoot.expired() && !oldSpecies.expired());
+    }
+    tree.apply({});
+    CHECK_EQ(tree.retiredCount(), size_t(0));
+    CHECK(oldRoot.expired());
+    CHECK(oldSpecies.expired());
+}
+
+TEST(publishCopiesOnlyChangedPaths) {
+    ConcurrentTree tree(firstGeneration());
+    ConcurrentTree::ReadGuard before = tree.read();
+    tree.apply({LogRecord{0, LogOp::Update, speciesPathOf(0, 4), "Renamed", "https://en.wikipedia.org/wiki/Shark", ""}});
+    ConcurrentTree::ReadGuard after = tree.read();
+
+    // path Class/O1/F4/G4 disalin, Order dan Family lain dipakai bersama
+    CHECK(before->root.get() != after->root.get());
+    CHECK(before->root->child("O0") == after->root->child("O0"));
+    CHECK(before->root->child("O2") == after->root->child("O2"));
+    CHECK(before->root->child("O1") != after->root->child("O1"));
+    CHECK(before->root->child("O1")->child("F0") == after->root->child("O1")->child("F0"));
+    CHECK(before->findPath(speciesPathOf(0, 4))->commonName == "gen 0");
+    CHECK(after->search("renamed") == after->findPath(speciesPathOf(0, 4)));
+    CHECK(before->search("renamed") == nullptr);
+
+    // batch tanpa perubahan tidak menyalin apa pun
+    tree.apply({});
+    ConcurrentTree::ReadGuard again = tree.read();
+    CHECK(again->root.get() == after->root.get());
+    CHECK(again.number() == after.number() + 1);
+}
+
+TEST(searchMatchesTreeSearchUnderRandomEdits) {
+    std::mt19937 rng(9);
+    Node* reference = buildRandomTree(rng, 300);
+    rng.seed(9);
+    ConcurrentTree tree(buildRandomTree(rng, 300));
+
+    auto name = [&rng] { return (rng() % 4 == 0) ? "Shark " + std::to_string(rng() % 12) : "n" + std::to_string(rng() % 6); };
+    for (int round = 0; round < 200; ++round) {
+        std::vector<LogRecord> batch;
+        for (int i = 0, count = 1 + rng() % 8; i < count; ++i) {
+            LogRecord record;
+            record.op = static_cast<LogOp>(1 + rng() % 3);
+            record.path = {"Chondrichthyes", name(), name(), name(), name()};
+            for (size_t level = 1; level < record.path.size(); ++level) {
+                if (record.path[level].front() == 'S') record.path[level] = "n" + std::to_string(rng() % 6);
+            }
+            record.commonName = "Shark " + std::to_string(rng() % 12);
+            record.name = name();
+            batch.push_back(record);
+            applyLogRecord(reference, record);
+        }
+        tree.apply(batch);
+
+        ConcurrentTree::ReadGuard guard = tree.read();
+        CHECK_EQ(guard->speciesCount(), speciesCount(reference));
+        for (int q = 0; q < 20; ++q) {
+            std::string query = name();
+            Node* expected = searchNode(reference, query);
+            const VersionNode* found = guard->search(query);
+            if ((expected == nullptr) != (found == nullptr) || (expected && nodePath(expected) != versionPath(found))) {
+                std::cerr << "[FAIL] search '" << query << "' in round " << round << "\n";
+                CHECK(false);
+                deleteTree(reference);
+                return;
+            }
+            if (found) CHECK(found->commonName == nodeCommonName(expected));
+        }
+    }
+    deleteTree(reference);
+}
+
+int main() {
+    return runTests();
+}
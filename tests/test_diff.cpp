@@ -0,0 +1,98 @@
+// Test diff.cpp: species yang ditambah, dihapus dan diubah antara dua tree
+#include "test_util.h"
+#include "diff.h"
+
+struct Collected {
+    std::vector<std::string> added, removed, changed;
+    DiffStats stats;
+};
+
+static Collected runDiff(const Node* before, const Node* after) {
+    Collected result;
+    result.stats = diffTrees(before, after, [&](const DiffEntry& entry) {
+        const Node* node = entry.after ? entry.after : entry.before;
+        std::string path;
+        for (const std::string& name : nodePath(node)) path += "/" + name;
+        (entry.kind == DiffKind::Added ? result.added : entry.kind == DiffKind::Removed ? result.removed : result.changed).push_back(path);
+    });
+    return result;
+}
+
+// Class -> Order -> Family -> Genus dengan species yang diberikan, dibangun tanpa cek nama kembar
+static Node* handBuilt(const std::vector<std::string>& genera) {
+    Node* root = appendChild(nullptr, "Chondrichthyes", Rank::Class);
+    Node* family = appendChild(appendChild(root, "Lamniformes", Rank::Order), "Lamnidae", Rank::Family);
+    for (const std::string& genus : genera) {
+        appendChild(appendChild(family, genus, Rank::Genus), genus + "_species", Rank::Species);
+    }
+    return root;
+}
+
+TEST(identicalTreesHaveNoDifferences) {
+    std::mt19937 rng(23);
+    Node* before = buildRandomTree(rng, 200);
+    rng.seed(23);
+    Node* after = buildRandomTree(rng, 200);
+    Collected diff = runDiff(before, after);
+    CHECK(diff.added.empty() && diff.removed.empty() && diff.changed.empty());
+    CHECK_EQ(diff.stats.visited, size_t(0));
+    deleteTree(before);
+    deleteTree(after);
+}
+
+TEST(reportsAddedRemovedAndChangedSpecies) {
+    Node* before = nullptr;
+    Node* after = nullptr;
+    addSpecies(before, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"}, "Great White Shark");
+    addSpecies(before, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Isurus", "oxyrinchus"}, "Mako");
+    addSpecies(before, {"Chondrichthyes", "Orectolobiformes", "Rhincodontidae", "Rhincodon", "typus"}, "Whale Shark");
+    // anak after sengaja dalam urutan lain
+    addSpecies(after, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Isurus", "oxyrinchus"}, "Shortfin Mako");
+    addSpecies(after, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"}, "Great White Shark");
+    addSpecies(after, {"Chondrichthyes", "Carcharhiniformes", "Carcharhinidae", "Galeocerdo", "cuvier"}, "Tiger Shark");
+
+    Collected diff = runDiff(before, after);
+    CHECK(diff.changed == std::vector<std::string>{"/Chondrichthyes/Lamniformes/Lamnidae/Isurus/oxyrinchus"});
+    CHECK(diff.removed == std::vector<std::string>{"/Chondrichthyes/Orectolobiformes/Rhincodontidae/Rhincodon/typus"});
+    CHECK(diff.added == std::vector<std::string>{"/Chondrichthyes/Carcharhiniformes/Carcharhinidae/Galeocerdo/cuvier"});
+    deleteTree(before);
+    deleteTree(after);
+}
+
+TEST(duplicateSiblingNamesArePairedOnce) {
+    // before = {A, A}, after = {A, B}: satu A berpasangan, A kedua dihapus, B ditambahkan
+    Node* before = handBuilt({"Lamna", "Lamna"});
+    Node* after = handBuilt({"Lamna", "Isurus"});
+    Collected diff = runDiff(before, after);
+    CHECK(diff.added == std::vector<std::string>{"/Chondrichthyes/Lamniformes/Lamnidae/Isurus/Isurus_species"});
+    CHECK(diff.removed == std::vector<std::string>{"/Chondrichthyes/Lamniformes/Lamnidae/Lamna/Lamna_species"});
+
+    // sebaliknya: before = {B, A}, after = {A, A}
+    Node* reordered = handBuilt({"Isurus", "Lamna"});
+    Node* twins = handBuilt({"Lamna", "Lamna"});
+    diff = runDiff(reordered, twins);
+    CHECK(diff.added == std::vector<std::string>{"/Chondrichthyes/Lamniformes/Lamnidae/Lamna/Lamna_species"});
+    CHECK(diff.removed == std::vector<std::string>{"/Chondrichthyes/Lamniformes/Lamnidae/Isurus/Isurus_species"});
+
+    deleteTree(before);
+    deleteTree(after);
+    deleteTree(reordered);
+    deleteTree(twins);
+}
+
+TEST(differentRootsReplaceEverything) {
+    Node* before = handBuilt({"Lamna"});
+    Node* after = appendChild(nullptr, "Actinopterygii", Rank::Class);
+    appendChild(appendChild(appendChild(appendChild(after, "Perciformes", Rank::Order), "Percidae", Rank::Family), "Perca", Rank::Genus),
+                "fluviatilis", Rank::Species);
+    Collected diff = runDiff(before, after);
+    CHECK_EQ(diff.removed.size(), size_t(1));
+    CHECK_EQ(diff.added.size(), size_t(1));
+    CHECK_EQ(runDiff(nullptr, after).added.size(), size_t(1));
+    deleteTree(before);
+    deleteTree(after);
+}
+
+int main() {
+    return runTests();
+}
@@ -0,0 +1,153 @@
+// Test forest.cpp & importForestFile: baris beberapa Class masuk ke shard yang benar dan bisa dicari lewat indeks global
+#include "test_util.h"
+#include "batch.h"
+#include "forest.h"
+#include "importer.h"
+#include "parallel.h"
+#include <fstream>
+#include <set>
+#include <sstream>
+
+// Class, Order, Family, Genus, Species, CommonName
+static const char* const ROWS[][6] = {
+    {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias", "Great White Shark"},
+    {"Chondrichthyes", "Myliobatiformes", "Dasyatidae", "Dasyatis", "pastinaca", "Common Stingray"},
+    {"Actinopterygii", "Perciformes", "Percidae", "Perca", "fluviatilis", "European Perch"},
+    {"Actinopterygii", "Salmoniformes", "Salmonidae", "Salmo", "salar", "Atlantic Salmon"},
+    {"Holocephali", "Chimaeriformes", "Chimaeridae", "Chimaera", "monstrosa", "Rabbit Fish"},
+    // "Lamna" sebagai species di Class lain: nama yang sama di dua shard
+    {"Actinopterygii", "Perciformes", "Percidae", "Perca", "lamna", "Odd Perch"},
+    {"Chondrichthyes", "Lamniformes", "Lamnidae", "Lamna", "nasus", "Porbeagle"},
+};
+
+static std::string writeRows(const TempDir& dir, size_t extraPerClass) {
+    std::string file = dir.file("rows.csv");
+    std::ofstream out(file, std::ios::binary);
+    out << "Class,Order,Family,Genus,Species,CommonName\n";
+    for (const auto& row : ROWS) {
+        for (size_t i = 0; i < 6; ++i) out << row[i] << (i + 1 < 6 ? "," : "\n");
+    }
+    // cukup banyak baris supaya setiap shard dibangun sebagai task sendiri
+    const char* const classes[] = {"Chondrichthyes", "Actinopterygii", "Holocephali"};
+    for (size_t i = 0; i < extraPerClass; ++i) {
+        for (const char* className : classes) {
+            out << className << ",O" << i % 7 << ",F" << i % 13 << ",G" << i % 29 << "," << className << "_sp" << i << ",Fish " << i << "\n";
+        }
+    }
+    return file;
+}
+
+static std::string shardClass(const Forest& forest, const Node* node) {
+    uint32_t index = forest.shardOf(node);
+    return index == Forest::NONE ? std::string() : std::string(forest.shard(index)->name.str());
+}
+
+TEST(importRoutesEveryClassToItsShard) {
+    TempDir dir("forest_import");
+    std::string file = writeRows(dir, 1000);
+    ThreadPool pool(4);
+    Forest forest(Rank::Class);
+    ImportStats stats;
+    CHECK(importForestFile(forest, file, &stats, &pool));
+    CHECK_EQ(stats.rejected, size_t(0));
+    CHECK_EQ(stats.added, std::size(ROWS) + 3000);
+    CHECK_EQ(forest.shardCount(), uint32_t(3));
+    CHECK_EQ(forest.speciesCount(), std::size(ROWS) + 3000);
+
+    // setiap shard memuat tepat satu Class, dan setiap baris ada di shard Class-nya
+    std::set<std::string> roots;
+    for (uint32_t i = 0; i < forest.shardCount(); ++i) roots.insert(std::string(forest.shard(i)->name.str()));
+    CHECK(roots == std::set<std::string>({"Chondrichthyes", "Actinopterygii", "Holocephali"}));
+    for (const auto& row : ROWS) {
+        std::vector<std::string> path(row, row + 5);
+        Node* species = forest.findPath(path);
+        CHECK(species != nullptr && species->rank == Rank::Species);
+        CHECK_EQ(shardClass(forest, species), std::string(row[0]));
+        CHECK(forest.search(row[5]) == species);
+    }
+    CHECK_EQ(shardClass(forest, forest.search("Holocephali_sp999")), std::string("Holocephali"));
+    for (uint32_t i = 0; i < forest.shardCount(); ++i) CHECK(checkSubtreeStats(forest.shard(i)));
+}
+
+TEST(globalIndexNarrowsLookupsToMatchingShards) {
+    TempDir dir("forest_index");
+    std::string file = writeRows(dir, 0);
+    Forest forest(Rank::Class);
+    CHECK(importForestFile(forest, file));
+
+    ShardRange salmon = forest.candidateShards("atlantic salmon");
+    CHECK(salmon.size() == 1 && forest.shard(*salmon.begin())->name == "Actinopterygii");
+    CHECK(forest.candidateShards("no such fish").empty());
+    CHECK(forest.search("no such fish") == nullptr);
+
+    // "Lamna" ada di dua shard: kedua shard kandidat, urut naik; search memilih shard terkecil
+    ShardRange lamna = forest.candidateShards("LAMNA");
+    CHECK_EQ(lamna.size(), size_t(2));
+    CHECK(lamna.size() == 2 && *lamna.begin() < *(lamna.begin() + 1));
+    Node* found = forest.search("lamna");
+    CHECK(found != nullptr && forest.shardOf(found) == *lamna.begin());
+
+    // query tanpa jangkar yang diawali nama persis hanya menyentuh shard kandidat
+    std::vector<std::string> matched;
+    std::string error = queryForest(forest, "Perca/*", QueryFilter(), [&](Node* node) { matched.push_back(std::string(node->name.str())); });
+    CHECK(error.empty());
+    CHECK(matched == std::vector<std::string>({"fluviatilis", "lamna"}));
+
+    // delete lewat indeks global hanya menghapus di shard yang memuat nama itu
+    CHECK_EQ(forest.remove("lamna"), size_t(1));
+    CHECK(forest.search("lamna") != nullptr && forest.search("lamna")->rank == Rank::Genus);
+}
+
+TEST(orderShardsKeepClassRoots) {
+    TempDir dir("forest_order");
+    std::string file = writeRows(dir, 0);
+    Forest forest(Rank::Order);
+    CHECK(importForestFile(forest, file));
+    // Lamniformes, Myliobatiformes, Perciformes, Salmoniformes, Chimaeriformes
+    CHECK_EQ(forest.shardCount(), uint32_t(5));
+    for (uint32_t i = 0; i < forest.shardCount(); ++i) {
+        CHECK(forest.shard(i)->rank == Rank::Class && forest.shard(i)->children.size() == 1);
+    }
+    Node* perch = forest.search("European Perch");
+    CHECK(perch != nullptr && forest.shard(forest.shardOf(perch))->children[0]->name == "Perciformes");
+    CHECK(forest.findPath({"Actinopterygii", "Salmoniformes"}) != nullptr);
+}
+
+TEST(forestBatchAcceptsOtherClasses) {
+    TempDir dir("forest_batch");
+    std::string file = writeRows(dir, 0);
+    Forest forest(Rank::Class);
+    CHECK(importForestFile(forest, file));
+
+    std::string commands = dir.file("commands.txt");
+    {
+        std::ofstream out(commands, std::ios::binary);
+        out << "add\tSarcopterygii\tCoelacanthiformes\tLatimeriidae\tLatimeria\tchalumnae\tCoelacanth\n"
+            << "search coelacanth\n"
+            << "update rabbit fish\tRatfish\n"
+            << "delete salar\n"
+            << "query /Holocephali/**/*\twiki=no\n";
+    }
+    std::FILE* input = std::fopen(commands.c_str(), "rb");
+    std::ostringstream output;
+    BatchStats stats;
+    CHECK(runForestBatch(forest, input, output, &stats));
+    std::fclose(input);
+
+    CHECK_EQ(output.str(), std::string("added chalumnae\n"
+                                       "found Species: chalumnae [Coelacanth]\n"
+                                       "updated rabbit fish\n"
+                                       "deleted 1: salar\n"
+                                       "match Order: Chimaeriformes\n"
+                                       "match Family: Chimaeridae\n"
+                                       "match Genus: Chimaera\n"
+                                       "match Species: monstrosa [Ratfish]\n"
+                                       "end query: 4 matches\n"));
+    CHECK_EQ(stats.commands, size_t(5));
+    CHECK_EQ(forest.shardCount(), uint32_t(4));
+    CHECK_EQ(shardClass(forest, forest.search("ratfish")), std::string("Holocephali"));
+}
+
+int main() {
+    return runTests();
+}
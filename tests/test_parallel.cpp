@@ -0,0 +1,116 @@
+// Test parallel.cpp: hasil paralel harus sama dengan traversal sekuensial, berapa pun jadwal thread-nya
+#include "test_util.h"
+#include "parallel.h"
+#include <map>
+#include <mutex>
+
+static std::vector<Node*> sequentialPreOrder(Node* root) {
+    std::vector<Node*> nodes;
+    for (const TraversalEntry& entry : preOrder(root)) nodes.push_back(entry.node);
+    return nodes;
+}
+
+// cukup besar supaya setiap Class/Order/Family punya banyak anak dan benar-benar di-fork
+static Node* largeTree(unsigned seed) {
+    std::mt19937 rng(seed);
+    return buildRandomTree(rng, 5000, 12);
+}
+
+TEST(forEachVisitsEveryNodeOnce) {
+    ThreadPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    Node* root = largeTree(81);
+    std::vector<Node*> expected = sequentialPreOrder(root);
+
+    for (int round = 0; round < 20; ++round) {
+        std::mutex mutex;
+        std::map<Node*, int> visits;
+        parallelForEachNode(root, [&](Node* node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++visits[node];
+        }, options);
+        CHECK_EQ(visits.size(), expected.size());
+        bool once = true;
+        for (Node* node : expected) once = once && visits[node] == 1;
+        CHECK(once);
+    }
+    deleteTree(root);
+}
+
+TEST(findAllMatchesSequentialPreorder) {
+    ThreadPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    Node* root = largeTree(82);
+    std::vector<Node*> all = sequentialPreOrder(root);
+
+    const std::vector<std::function<bool(const Node*)>> predicates = {
+        [](const Node* node) { return node->name == "n3"; },
+        [](const Node* node) { return node->rank == Rank::Species && !nodeWikiLink(node).empty(); },
+        [](const Node* node) { return nodeCommonName(node) == "Shark 7"; },
+        [](const Node*) { return true; },
+        [](const Node*) { return false; },
+    };
+    std::vector<Node*> firstExpected;
+    for (const auto& predicate : predicates) {
+        std::vector<Node*> expected;
+        for (Node* node : all) {
+            if (predicate(node)) expected.push_back(node);
+        }
+        for (int round = 0; round < 10; ++round) {
+            CHECK(parallelFindAll(root, predicate, options) == expected);
+        }
+        if (firstExpected.empty()) firstExpected = expected;
+    }
+
+    // tanpa fork sama sekali hasilnya tetap sama
+    options.forkUntil = Rank::Class;
+    options.minFanout = all.size();
+    CHECK(!firstExpected.empty() && parallelFindAll(root, predicates[0], options) == firstExpected);
+    CHECK(parallelFindAll(nullptr, predicates[3], options).empty());
+    deleteTree(root);
+}
+
+TEST(speciesPerOrderMatchesSequentialCount) {
+    ThreadPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    Node* root = largeTree(83);
+
+    std::vector<std::pair<Node*, size_t>> expected;
+    for (Node* node : sequentialPreOrder(root)) {
+        if (node->rank == Rank::Order) expected.push_back({node, 0});
+        if (node->rank == Rank::Species) ++expected.back().second;
+    }
+    CHECK(expected.size() > 1);
+    for (int round = 0; round < 10; ++round) {
+        CHECK(speciesCountPerOrder(root, options) == expected);
+    }
+    size_t total = 0;
+    for (const auto& entry : expected) total += entry.second;
+    CHECK_EQ(total, speciesCount(root));
+    deleteTree(root);
+}
+
+TEST(nestedGroupsFinishOnSingleWorker) {
+    // satu worker: wait() harus menjalankan task sendiri atau tidur sampai task grup selesai
+    ThreadPool pool(1);
+    std::atomic<size_t> done{0};
+    {
+        TaskGroup outer(pool);
+        for (int i = 0; i < 50; ++i) {
+            outer.run([&pool, &done] {
+                TaskGroup inner(pool);
+                for (int j = 0; j < 20; ++j) inner.run([&done] { done.fetch_add(1); });
+                inner.wait();
+            });
+        }
+        outer.wait();
+    }
+    CHECK_EQ(done.load(), size_t(1000));
+}
+
+int main() {
+    return runTests();
+}
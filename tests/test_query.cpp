@@ -0,0 +1,98 @@
+// Test query.cpp: hasil pola path harus sama dan berurutan sama dengan pencocokan brute force
+#include "test_util.h"
+#include "query.h"
+#include "traversal.h"
+
+static bool matchesSegment(const std::string& segment, const std::string& name) {
+    return segment == "*" || globMatchFolded(segment, name);
+}
+
+// names[from..] cocok penuh dengan segments[index..]
+static bool matchesFrom(const std::vector<std::string>& segments, size_t index, const std::vector<std::string>& names, size_t from) {
+    if (index == segments.size()) return from == names.size();
+    if (segments[index] == "**") {
+        for (size_t skip = from; skip <= names.size(); ++skip) {
+            if (matchesFrom(segments, index + 1, names, skip)) return true;
+        }
+        return false;
+    }
+    return from < names.size() && matchesSegment(segments[index], names[from]) && matchesFrom(segments, index + 1, names, from + 1);
+}
+
+/**
+ * @brief Reference result: every node whose root path matches, in pre-order. An unanchored
+ *        pattern starting with a plain name may start at any level (see query.h).
+ */
+static std::vector<Node*> bruteForce(Node* root, const std::vector<std::string>& segments, bool anchored) {
+    bool floating = !anchored && segments[0].find_first_of("*?") == std::string::npos;
+    std::vector<Node*> result;
+    for (const TraversalEntry& entry : preOrder(root)) {
+        std::vector<std::string> names = nodePath(entry.node);
+        bool match = false;
+        for (size_t start = 0; start < (floating ? names.size() : 1) && !match; ++start) {
+            match = matchesFrom(segments, 0, names, start);
+        }
+        if (match) result.push_back(entry.node);
+    }
+    return result;
+}
+
+static std::string joinPattern(const std::vector<std::string>& segments, bool anchored) {
+    std::string pattern = anchored ? "/" : "";
+    for (size_t i = 0; i < segments.size(); ++i) pattern += (i ? "/" : "") + segments[i];
+    return pattern;
+}
+
+TEST(anyDepthResultsComeInPreorder) {
+    Node* root = nullptr;
+    // nama "Lamna" dipakai di tiga level: hasil "**/Lamn*" harus ikut urutan pre-order
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Lamna", "nasus"});
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "lamna"});
+    addSpecies(root, {"Chondrichthyes", "Lamna", "Odontaspididae", "Carcharias", "taurus"});
+
+    std::vector<std::string> names;
+    for (Node* node : queryPath(root, "**/lamn*")) names.push_back(node->name);
+    std::vector<std::string> expected = {"Lamniformes", "Lamnidae", "Lamna", "lamna", "Lamna"};
+    CHECK(names == expected);
+    deleteTree(root);
+}
+
+TEST(patternsMatchBruteForceOnRandomTrees) {
+    const std::vector<std::vector<std::string>> patterns = {
+        {"**", "n1"}, {"n1", "**"}, {"n1", "**", "n2"}, {"**", "n0", "n2"}, {"n1", "*"}, {"n1"},
+        {"n0", "**", "n1", "*"}, {"*", "**", "n1"}, {"Chondrichthyes", "**"}, {"n1", "n?"}, {"**"},
+    };
+    std::mt19937 rng(16);
+    for (int round = 0; round < 100; ++round) {
+        Node* root = buildRandomTree(rng, 60, 4);
+        for (const auto& segments : patterns) {
+            for (bool anchored : {false, true}) {
+                std::string pattern = joinPattern(segments, anchored);
+                std::vector<Node*> got;
+                QueryCursor cursor = queryPath(root, pattern);
+                CHECK(cursor.error().empty());
+                for (Node* node : cursor) got.push_back(node);
+                if (got != bruteForce(root, segments, anchored)) {
+                    std::cerr << "[FAIL] pattern '" << pattern << "' in round " << round << "\n";
+                    CHECK(got == bruteForce(root, segments, anchored));
+                    deleteTree(root);
+                    return;
+                }
+            }
+        }
+        deleteTree(root);
+    }
+}
+
+TEST(rejectsInvalidPatterns) {
+    Node* root = nullptr;
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Lamna", "nasus"});
+    QueryCursor cursor = queryPath(root, "**/Lamnidae/**");
+    CHECK(!cursor.error().empty());
+    CHECK(cursor.next() == nullptr);
+    deleteTree(root);
+}
+
+int main() {
+    return runTests();
+}
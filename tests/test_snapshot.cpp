@@ -0,0 +1,173 @@
+// Test snapshot.cpp: round trip dan penolakan image yang rusak
+#include "test_util.h"
+#include "snapshot.h"
+#include "traversal.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+static std::vector<Node*> preOrderNodes(Node* root) {
+    std::vector<Node*> nodes;
+    for (const TraversalEntry& entry : preOrder(root)) nodes.push_back(entry.node);
+    return nodes;
+}
+
+/**
+ * @brief Same shape, names, ranks and metadata in the same child order.
+ */
+static bool sameTree(Node* a, Node* b) {
+    std::vector<Node*> left = preOrderNodes(a), right = preOrderNodes(b);
+    if (left.size() != right.size()) return false;
+    for (size_t i = 0; i < left.size(); ++i) {
+        if (left[i]->name.str() != right[i]->name.str() || left[i]->rank != right[i]->rank ||
+            nodeCommonName(left[i]) != nodeCommonName(right[i]) || nodeWikiLink(left[i]) != nodeWikiLink(right[i]) ||
+            left[i]->children.size() != right[i]->children.size()) {
+            return false;
+        }
+    }
+    return contentHash(a) == contentHash(b);
+}
+
+template <typename T>
+static void patch(std::vector<char>& image, size_t offset, T value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+static SnapshotHeader headerOf(const std::vector<char>& image) {
+    SnapshotHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    return header;
+}
+
+TEST(roundTripThroughImageAndFile) {
+    std::mt19937 rng(11);
+    Node* root = buildRandomTree(rng, 500);
+    std::vector<char> image = buildSnapshotImage(root, 42);
+
+    SnapshotView view;
+    CHECK(view.attach(image.data(), image.size()));
+    CHECK_EQ(view.checkpointLsn(), uint64_t(42));
+    CHECK_EQ(view.nodeCount(), uint32_t(descendantCount(root) + 1));
+    Node* loaded = loadSnapshotTree(view);
+    CHECK(sameTree(root, loaded));
+    CHECK(checkSubtreeStats(loaded));
+
+    // search di view dan di tree hasil load sama dengan searchNode di tree asal
+    for (const char* name : {"n0", "N3", "shark 5", "Chondrichthyes", "missing"}) {
+        Node* expected = searchNode(root, name);
+        uint32_t index = view.search(name);
+        CHECK_EQ(index == SNAPSHOT_NONE, expected == nullptr);
+        if (expected && index != SNAPSHOT_NONE) {
+            CHECK(view.name(index) == expected->name.str());
+            CHECK(view.rank(index) == expected->rank);
+        }
+        Node* found = searchNode(loaded, name);
+        CHECK(found == nullptr ? expected == nullptr : expected != nullptr && nodePath(found) == nodePath(expected));
+    }
+
+    TempDir dir("snapshot");
+    CHECK(saveSnapshot(root, dir.file("tree.snap"), 7));
+    auto mapped = std::make_shared<SnapshotView>();
+    CHECK(mapped->open(dir.file("tree.snap")));
+    CHECK_EQ(mapped->checkpointLsn(), uint64_t(7));
+    Node* borrowed = loadSnapshotTree(std::shared_ptr<const SnapshotView>(mapped));
+    CHECK(sameTree(root, borrowed));
+
+    deleteTree(borrowed);
+    deleteTree(loaded);
+    deleteTree(root);
+}
+
+TEST(emptyTreeRoundTrip) {
+    std::vector<char> image = buildSnapshotImage(nullptr);
+    SnapshotView view;
+    CHECK(view.attach(image.data(), image.size()));
+    CHECK_EQ(view.nodeCount(), uint32_t(0));
+    CHECK(loadSnapshotTree(view) == nullptr);
+    CHECK_EQ(view.search("anything"), SNAPSHOT_NONE);
+}
+
+TEST(rejectsCorruptedHeadersAndStructure) {
+    std::mt19937 rng(12);
+    Node* root = buildRandomTree(rng, 50);
+    const std::vector<char> image = buildSnapshotImage(root);
+    const SnapshotHeader header = headerOf(image);
+    SnapshotView view;
+
+    auto rejects = [&](std::vector<char> corrupt) { return !view.attach(corrupt.data(), corrupt.size()); };
+
+    std::vector<char> corrupt = image;
+    corrupt[0] ^= 1;
+    CHECK(rejects(corrupt));                                                     // magic
+
+    corrupt = image;
+    corrupt.pop_back();
+    CHECK(rejects(corrupt));                                                     // file terpotong
+
+    corrupt = image;
+    patch(corrupt, offsetof(SnapshotHeader, nodeCount), header.nodeCount + 1);
+    CHECK(rejects(corrupt));                                                     // node di luar section
+
+    corrupt = image;
+    patch(corrupt, offsetof(SnapshotHeader, stringsOffset), uint64_t(0) - 8);
+    CHECK(rejects(corrupt));                                                     // offset overflow
+
+    corrupt = image;
+    patch(corrupt, offsetof(SnapshotHeader, nodesOffset), uint64_t(0));
+    CHECK(rejects(corrupt));                                                     // node menimpa header
+
+    // anak pertama root menunjuk ke node lain (bukan subtree berikutnya)
+    corrupt = image;
+    patch(corrupt, header.childrenOffset, header.nodeCount - 1);
+    CHECK(rejects(corrupt));
+
+    // parent node 1 bukan root
+    corrupt = image;
+    patch(corrupt, header.nodesOffset + sizeof(SnapshotNode) + offsetof(SnapshotNode, parent), uint32_t(1));
+    CHECK(rejects(corrupt));
+
+    // rank yang tidak sama dengan kedalaman
+    corrupt = image;
+    patch(corrupt, header.nodesOffset + sizeof(SnapshotNode) + offsetof(SnapshotNode, rank), uint8_t(3));
+    CHECK(rejects(corrupt));
+
+    // hash table tanpa bucket kosong membuat search berputar terus
+    corrupt = image;
+    for (uint32_t bucket = 0; bucket < header.hashBuckets; ++bucket) {
+        patch(corrupt, header.hashOffset + bucket * sizeof(uint32_t), uint32_t(1));
+    }
+    CHECK(rejects(corrupt));
+
+    CHECK(view.attach(image.data(), image.size()));
+    deleteTree(root);
+}
+
+TEST(randomlyCorruptedImagesNeverLoadBrokenTrees) {
+    std::mt19937 rng(13);
+    Node* root = buildRandomTree(rng, 40);
+    const std::vector<char> image = buildSnapshotImage(root);
+    size_t accepted = 0;
+
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<char> corrupt = image;
+        for (int flips = 1 + rng() % 4; flips > 0; --flips) {
+            corrupt[rng() % corrupt.size()] = static_cast<char>(rng());
+        }
+        SnapshotView view;
+        if (!view.attach(corrupt.data(), corrupt.size())) continue;
+
+        // image yang diterima harus bisa dipakai penuh tanpa membaca di luar buffer
+        ++accepted;
+        Node* loaded = loadSnapshotTree(view);
+        CHECK(checkSubtreeStats(loaded));
+        view.search("n1");
+        view.search("Shark 3");
+        deleteTree(loaded);
+    }
+    CHECK(accepted > 0);   // mutasi di string blob tetap valid
+    deleteTree(root);
+}
+
+int main() {
+    return runTests();
+}
@@ -0,0 +1,256 @@
+// Test tree.cpp: name index, search dan delete
+#include "test_util.h"
+#include "traversal.h"
+#include "wal.h"
+
+/**
+ * @brief Every name index key must point into the name or common name of a node in its own
+ *        bucket (never into freed text), and every live node must be findable under both names.
+ */
+static bool nameIndexConsistent(Node* root) {
+    if (root == nullptr) return true;
+    const auto& names = root->ctx->nameIndex;
+    for (const auto& entry : names) {
+        bool owned = false;
+        for (const Node* node : entry.second) {
+            owned = owned || entry.first.data() == node->name.str().data() || entry.first.data() == nodeCommonName(node).data();
+            if (!equalsFolded(node->name.str(), entry.first) && !equalsFolded(nodeCommonName(node), entry.first)) return false;
+        }
+        if (!owned) return false;
+    }
+    for (const TraversalEntry& entry : preOrder(root)) {
+        Node* node = entry.node;
+        auto it = names.find(node->name.str());
+        if (it == names.end() || std::find(it->second.begin(), it->second.end(), node) == it->second.end()) return false;
+        if (!nodeCommonName(node).empty()) {
+            it = names.find(nodeCommonName(node));
+            if (it == names.end() || std::find(it->second.begin(), it->second.end(), node) == it->second.end()) return false;
+        }
+    }
+    return true;
+}
+
+TEST(nameIndexKeyMovesToRemainingNodeOnDelete) {
+    Node* root = nullptr;
+    addSpecies(root, {"Chondrichthyes", "Squatiniformes", "Squatinidae", "Squatina", "dumeril"}, "Angel Shark");
+    addSpecies(root, {"Chondrichthyes", "Squatiniformes", "Squatinidae", "Squatina", "japonica"}, "angel shark");
+    Node* first = searchNode(root, "dumeril");
+    CHECK(first != nullptr && first->rank == Rank::Species);
+
+    // key bucket "angel shark" menunjuk ke common name species pertama
+    CHECK_EQ(deleteSpeciesRecord(root, "dumeril"), size_t(1));
+    CHECK(nameIndexConsistent(root));
+    Node* found = searchNode(root, "ANGEL SHARK");
+    CHECK(found != nullptr && found->name == "japonica");
+    deleteTree(root);
+}
+
+TEST(nameIndexKeyMovesToRemainingNodeOnUpdate) {
+    Node* root = nullptr;
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Isurus", "oxyrinchus"}, "Mako");
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Isurus", "paucus"}, "MAKO");
+    Node* first = searchNode(root, "oxyrinchus");
+
+    CHECK(updateSpeciesRecord(first, "Shortfin Mako", ""));
+    CHECK(nameIndexConsistent(root));
+    Node* found = searchNode(root, "mako");
+    CHECK(found != nullptr && found->name == "paucus");
+    CHECK(searchNode(root, "shortfin mako") == first);
+    deleteTree(root);
+}
+
+TEST(searchReturnsFirstMatchInPreorder) {
+    Node* root = nullptr;
+    // "Carcharias" adalah Genus di satu cabang dan species di cabang sebelumnya
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"}, "Great White Shark");
+    addSpecies(root, {"Chondrichthyes", "Lamniformes", "Odontaspididae", "Carcharias", "taurus"}, "Sand Tiger");
+    Node* found = searchNode(root, "CARCHARIAS");
+    CHECK(found != nullptr && found->rank == Rank::Species);
+
+    Node* lamnidae = searchNode(root, "Lamnidae");
+    CHECK(searchNode(lamnidae, "carcharias") == found);
+    Node* odontaspididae = searchNode(root, "Odontaspididae");
+    found = searchNode(odontaspididae, "carcharias");
+    CHECK(found != nullptr && found->rank == Rank::Genus);
+    deleteTree(root);
+}
+
+TEST(preorderComparisonIsStrictAcrossTrees) {
+    std::mt19937 rng(8);
+    Node* first = buildRandomTree(rng, 30);
+    Node* second = buildRandomTree(rng, 30);
+    std::vector<Node*> nodes;
+    for (Node* root : {first, second}) {
+        for (const TraversalEntry& entry : preOrder(root)) nodes.push_back(entry.node);
+    }
+
+    for (Node* node : nodes) CHECK(!precedesInPreorder(node, node));
+    Node* deepFirst = nodes[4];
+    Node* deepSecond = nodes.back();
+    CHECK(precedesInPreorder(deepFirst, deepSecond) != precedesInPreorder(deepSecond, deepFirst));
+    CHECK_EQ(precedesInPreorder(deepFirst, second), precedesInPreorder(first, deepSecond));
+
+    // campuran dua tree tersusun per tree, dan di dalam setiap tree dalam pre-order
+    std::vector<Node*> sorted = nodes;
+    std::shuffle(sorted.begin(), sorted.end(), rng);
+    std::sort(sorted.begin(), sorted.end(), precedesInPreorder);
+    size_t firstCount = descendantCount(first) + 1;
+    bool firstTreeFirst = sorted.front()->ctx == first->ctx;
+    std::vector<Node*> expected(nodes.begin() + (firstTreeFirst ? 0 : firstCount), nodes.begin() + (firstTreeFirst ? firstCount : nodes.size()));
+    expected.insert(expected.end(), nodes.begin() + (firstTreeFirst ? firstCount : 0), nodes.begin() + (firstTreeFirst ? nodes.size() : firstCount));
+    CHECK(sorted == expected);
+
+    deleteTree(first);
+    deleteTree(second);
+}
+
+TEST(nameIndexStaysConsistentUnderRandomEdits) {
+    std::mt19937 rng(7);
+    Node* root = buildRandomTree(rng, 300);
+    CHECK(nameIndexConsistent(root));
+    for (int step = 0; step < 400 && root != nullptr; ++step) {
+        std::string name = "n" + std::to_string(rng() % 6);
+        switch (rng() % 3) {
+            case 0:
+                addSpecies(root, {"Chondrichthyes", "n" + std::to_string(rng() % 6), "n" + std::to_string(rng() % 6),
+                                  "n" + std::to_string(rng() % 6), name},
+                           "Shark " + std::to_string(rng() % 12));
+                break;
+            case 1: {
+                Node* node = searchNode(root, name);
+                if (node && node->rank == Rank::Species) updateSpeciesRecord(node, "Shark " + std::to_string(rng() % 12), "");
+                break;
+            }
+            default:
+                deleteSpeciesRecord(root, (rng() % 2) ? name : "Shark " + std::to_string(rng() % 12));
+        }
+        if (!nameIndexConsistent(root)) {
+            CHECK(nameIndexConsistent(root));
+            break;
+        }
+    }
+    deleteTree(root);
+}
+
+static std::string randomName(std::mt19937& rng) {
+    return "n" + std::to_string(rng() % 6);
+}
+
+static std::vector<std::string> randomPath(std::mt19937& rng) {
+    return {"Chondrichthyes", randomName(rng), randomName(rng), randomName(rng), randomName(rng)};
+}
+
+static std::string randomLink(std::mt19937& rng) {
+    return (rng() % 2) ? "" : "https://en.wikipedia.org/wiki/" + randomName(rng);
+}
+
+TEST(subtreeStatsStayExactUnderMixedEdits) {
+    std::mt19937 rng(17);
+    Node* root = buildRandomTree(rng, 200);
+    CHECK(checkSubtreeStats(root));
+
+    for (int step = 0; step < 2000; ++step) {
+        int kind = rng() % 6;
+        switch (kind) {
+            case 0:
+                addSpecies(root, randomPath(rng), "Shark " + std::to_string(rng() % 12), randomLink(rng));
+                break;
+            case 1: {
+                // update yang hanya mengubah wiki link (linkedSpecies) atau common name (contentHash)
+                Node* node = searchNode(root, randomName(rng));
+                if (node && node->rank == Rank::Species) {
+                    updateSpeciesRecord(node, (rng() % 2) ? std::string(nodeCommonName(node)) : "Shark " + std::to_string(rng() % 12),
+                                        randomLink(rng));
+                }
+                break;
+            }
+            case 2:
+                deleteSpeciesRecord(root, randomName(rng));
+                break;
+            case 3:
+                deleteSpeciesBatch(root, {randomName(rng), "Shark " + std::to_string(rng() % 12), randomName(rng)});
+                break;
+            case 4: {
+                // replay seperti recoverTree
+                LogRecord record;
+                record.op = static_cast<LogOp>(1 + rng() % 3);
+                record.path = randomPath(rng);
+                record.commonName = "Shark " + std::to_string(rng() % 12);
+                record.wikiLink = randomLink(rng);
+                record.name = randomName(rng);
+                applyLogRecord(root, record);
+                break;
+            }
+            default: {
+                // subtree non-root dilepas sekaligus
+                Node* node = searchNode(root, randomName(rng));
+                if (node && node->parent) deleteTree(node);
+            }
+        }
+        if (!checkSubtreeStats(root)) {
+            std::cerr << "[FAIL] stale subtree stats after step " << step << " (kind " << kind << ")\n";
+            CHECK(checkSubtreeStats(root));
+            break;
+        }
+    }
+    deleteTree(root);
+}
+
+TEST(contentHashIgnoresInsertOrder) {
+    std::mt19937 rng(18);
+    std::vector<std::vector<std::string>> paths;
+    for (int i = 0; i < 100; ++i) paths.push_back(randomPath(rng));
+
+    Node* forward = nullptr;
+    Node* backward = nullptr;
+    for (const auto& path : paths) addSpecies(forward, path, "Shark " + path.back());
+    for (auto it = paths.rbegin(); it != paths.rend(); ++it) addSpecies(backward, *it, "Shark " + it->back());
+    CHECK_EQ(contentHash(forward), contentHash(backward));
+    CHECK_EQ(speciesCount(forward), speciesCount(backward));
+
+    // satu perubahan metadata terlihat di root, dan hilang lagi saat dikembalikan
+    Node* species = searchNode(forward, paths[0].back());
+    std::string commonName(nodeCommonName(species));
+    updateSpeciesRecord(species, "Renamed", "");
+    CHECK(contentHash(forward) != contentHash(backward));
+    updateSpeciesRecord(species, commonName, "");
+    CHECK_EQ(contentHash(forward), contentHash(backward));
+    CHECK(checkSubtreeStats(forward) && checkSubtreeStats(backward));
+    deleteTree(forward);
+    deleteTree(backward);
+}
+
+TEST(batchDeleteMatchesRepeatedDeletes) {
+    for (unsigned seed = 0; seed < 50; ++seed) {
+        std::mt19937 rng(seed);
+        Node* batched = buildRandomTree(rng, 150);
+        rng.seed(seed);
+        Node* sequential = buildRandomTree(rng, 150);
+
+        // nama taksonomi dan common name campur, dengan nama yang berulang
+        std::vector<std::string> names;
+        for (int i = 0; i < 8; ++i) names.push_back((rng() % 2) ? randomName(rng) : "Shark " + std::to_string(rng() % 12));
+        names.push_back(names.front());
+
+        std::vector<size_t> removed;
+        size_t total = deleteSpeciesBatch(batched, names, &removed);
+        size_t expectedTotal = 0;
+        for (size_t i = 0; i < names.size(); ++i) {
+            size_t expected = deleteSpeciesRecord(sequential, names[i]);
+            CHECK_EQ(removed[i], expected);
+            expectedTotal += expected;
+        }
+        CHECK_EQ(total, expectedTotal);
+        CHECK_EQ(removed.back(), size_t(0));
+        CHECK_EQ(contentHash(batched), contentHash(sequential));
+        CHECK_EQ(descendantCount(batched), descendantCount(sequential));
+        CHECK(checkSubtreeStats(batched));
+        CHECK(nameIndexConsistent(batched));
+        deleteTree(batched);
+        deleteTree(sequential);
+    }
+}
+
+int main() {
+    return runTests();
+}
@@ -0,0 +1,112 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include "tree.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// --- MINI TEST HARNESS ---
+// TEST(nama) { ... } mendaftarkan satu test; CHECK/CHECK_EQ mencatat kegagalan ke std::cerr
+// dan test tetap berjalan. main() setiap file test cukup "return runTests();".
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<TestCase>& testCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool registerTest(const char* name, void (*run)()) {
+    testCases().push_back({name, run});
+    return true;
+}
+
+#define TEST(name)                                                   \
+    static void name();                                              \
+    static const bool name##Registered = registerTest(#name, name);  \
+    static void name()
+
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            ++testFailures();                                                                   \
+            std::cerr << "[FAIL] " << __FILE__ << ":" << __LINE__ << ": " << #condition << "\n"; \
+        }                                                                                       \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                             \
+    do {                                                                                       \
+        const auto& actualValue_ = (actual);                                                   \
+        const auto& expectedValue_ = (expected);                                               \
+        if (!(actualValue_ == expectedValue_)) {                                               \
+            ++testFailures();                                                                  \
+            std::cerr << "[FAIL] " << __FILE__ << ":" << __LINE__ << ": " << #actual << " == " \
+                      << #expected << " (" << actualValue_ << " vs " << expectedValue_ << ")\n"; \
+        }                                                                                      \
+    } while (0)
+
+inline int runTests() {
+    for (const TestCase& test : testCases()) {
+        int before = testFailures();
+        test.run();
+        std::cerr << (testFailures() == before ? "[PASS] " : "[FAIL] ") << test.name << "\n";
+    }
+    return testFailures() == 0 ? 0 : 1;
+}
+
+// --- FIXTURE ---
+
+// Direktori sementara per test, dihapus beserta isinya saat keluar scope
+class TempDir {
+public:
+    explicit TempDir(const std::string& name) {
+        path_ = std::filesystem::temp_directory_path() / ("tubes_hiu_" + name + "_" + std::to_string(std::random_device()()));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+    std::string file(const std::string& name) const { return (path_ / name).string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Insert tanpa log ke std::cout; path Class..Species
+inline void addSpecies(Node*& root, const std::vector<std::string>& path, const std::string& commonName = "",
+                       const std::string& wikiLink = "") {
+    std::vector<std::string_view> names(path.begin(), path.end());
+    insertSpeciesRecord(root, names, commonName, wikiLink);
+}
+
+// Taksonomi acak dengan nama dari pool kecil, jadi nama yang sama muncul di banyak cabang
+// dan di beberapa level sekaligus (kasus sulit untuk name index, query dan delete)
+inline Node* buildRandomTree(std::mt19937& rng, size_t species, size_t namePool = 6) {
+    Node* root = nullptr;
+    for (size_t i = 0; i < species; ++i) {
+        std::vector<std::string> path = {"Chondrichthyes"};
+        for (size_t level = 1; level < REQUIRED_TAX_LEVELS; ++level) {
+            path.push_back("n" + std::to_string(rng() % namePool));
+        }
+        std::string commonName = (rng() % 3 == 0) ? "" : "Shark " + std::to_string(rng() % (namePool * 2));
+        std::string wikiLink = (rng() % 2 == 0) ? "" : "https://en.wikipedia.org/wiki/" + path.back();
+        addSpecies(root, path, commonName, wikiLink);
+    }
+    return root;
+}
+
+#endif
@@ -0,0 +1,165 @@
+// Test wal.cpp: replay operation log, ekor yang terpotong, checkpoint
+#include "test_util.h"
+#include "snapshot.h"
+#include "wal.h"
+#include <fstream>
+
+static const std::vector<std::string> GREAT_WHITE = {"Chondrichthyes", "Lamniformes", "Lamnidae", "Carcharodon", "carcharias"};
+static const std::vector<std::string> TIGER = {"Chondrichthyes", "Carcharhiniformes", "Carcharhinidae", "Galeocerdo", "cuvier"};
+static const std::vector<std::string> MAKO = {"Chondrichthyes", "Lamniformes", "Lamnidae", "Isurus", "oxyrinchus"};
+
+// menulis tiga record lalu menutup log; mengembalikan ukuran file sesudahnya
+static uint64_t writeThreeRecords(const std::string& logFile) {
+    OperationLog log;
+    CHECK(log.open(logFile, 0));
+    log.logAdd(GREAT_WHITE, "Great White Shark", "https://en.wikipedia.org/wiki/Great_white_shark");
+    log.logAdd(TIGER, "Tiger Shark", "");
+    CHECK(log.waitDurable(log.logUpdate(TIGER, "Tiger Shark", "https://en.wikipedia.org/wiki/Tiger_shark")));
+    log.close();
+    return std::filesystem::file_size(logFile);
+}
+
+static void appendBytes(const std::string& file, const std::string& bytes) {
+    std::ofstream out(file, std::ios::binary | std::ios::app);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+TEST(replaysIntactRecords) {
+    TempDir dir("wal_replay");
+    std::string logFile = dir.file("tree.snap.wal");
+    writeThreeRecords(logFile);
+
+    Node* root = nullptr;
+    uint64_t lastLsn = 0;
+    CHECK(recoverTree(dir.file("tree.snap"), logFile, root, lastLsn));
+    CHECK_EQ(lastLsn, uint64_t(3));
+    CHECK_EQ(speciesCount(root), size_t(2));
+    Node* tiger = findPath(root, TIGER);
+    CHECK(tiger != nullptr && nodeWikiLink(tiger) == "https://en.wikipedia.org/wiki/Tiger_shark");
+    deleteTree(root);
+}
+
+TEST(tornTailIsTruncatedAndReplayContinues) {
+    TempDir dir("wal_torn");
+    std::string logFile = dir.file("tree.snap.wal");
+    uint64_t intactSize = writeThreeRecords(logFile);
+
+    // crash di tengah write: header record lengkap, payload baru sebagian
+    std::string torn(8, '\0');
+    torn[0] = 40;
+    torn += "partial";
+    appendBytes(logFile, torn);
+
+    std::vector<LogRecord> records;
+    CHECK(readLogRecords(logFile, records));
+    CHECK_EQ(records.size(), size_t(3));
+    CHECK_EQ(std::filesystem::file_size(logFile), intactSize);
+
+    // log bisa ditambah lagi sesudah ekor dipotong, dan replay membaca semuanya
+    OperationLog log;
+    CHECK(log.open(logFile, 3));
+    CHECK(log.waitDurable(log.logAdd(MAKO, "Shortfin Mako", "")));
+    log.close();
+
+    Node* root = nullptr;
+    uint64_t lastLsn = 0;
+    CHECK(recoverTree(dir.file("tree.snap"), logFile, root, lastLsn));
+    CHECK_EQ(lastLsn, uint64_t(4));
+    CHECK_EQ(speciesCount(root), size_t(3));
+    CHECK(findPath(root, MAKO) != nullptr);
+    deleteTree(root);
+}
+
+TEST(corruptTailRecordIsTruncated) {
+    TempDir dir("wal_crc");
+    std::string logFile = dir.file("tree.snap.wal");
+    uint64_t intactSize = writeThreeRecords(logFile);
+
+    // byte terakhir record ketiga rusak: CRC tidak cocok, record itu dan sesudahnya dibuang
+    {
+        std::fstream file(logFile, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(intactSize - 1));
+        file.put('\x7f');
+    }
+    std::vector<LogRecord> records;
+    CHECK(readLogRecords(logFile, records));
+    CHECK_EQ(records.size(), size_t(2));
+    CHECK(std::filesystem::file_size(logFile) < intactSize);
+}
+
+// CRC-32 yang sama dengan wal.cpp (polinom 0xEDB88320)
+static uint32_t crc32(const std::string& data) {
+    uint32_t crc = ~0u;
+    for (unsigned char byte : data) {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; ++bit) crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    return ~crc;
+}
+
+TEST(undecodableIntactRecordFailsRecoveryWithoutTruncating) {
+    TempDir dir("wal_undecodable");
+    std::string logFile = dir.file("tree.snap.wal");
+    writeThreeRecords(logFile);
+
+    // record #4 dengan op yang tidak dikenal build ini tetapi CRC-nya benar, lalu record #5 yang valid
+    uint64_t lsn = 4;
+    std::string payload(reinterpret_cast<const char*>(&lsn), sizeof(lsn));
+    payload += '\x09';
+    uint32_t length = static_cast<uint32_t>(payload.size());
+    uint32_t crc = crc32(payload);
+    std::string record(reinterpret_cast<const char*>(&length), sizeof(length));
+    record.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    appendBytes(logFile, record + payload);
+    {
+        OperationLog log;
+        CHECK(log.open(logFile, 4));
+        CHECK(log.waitDurable(log.logAdd(MAKO, "Shortfin Mako", "")));
+    }
+    uint64_t size = std::filesystem::file_size(logFile);
+
+    std::vector<LogRecord> records;
+    CHECK(!readLogRecords(logFile, records));
+    CHECK(records.empty());
+    CHECK_EQ(std::filesystem::file_size(logFile), size);
+
+    Node* root = nullptr;
+    uint64_t lastLsn = 0;
+    CHECK(!recoverTree(dir.file("tree.snap"), logFile, root, lastLsn));
+    CHECK_EQ(std::filesystem::file_size(logFile), size);
+    deleteTree(root);
+}
+
+TEST(checkpointDropsCoveredRecords) {
+    TempDir dir("wal_checkpoint");
+    std::string snapshotFile = dir.file("tree.snap");
+    std::string logFile = snapshotFile + ".wal";
+    writeThreeRecords(logFile);
+
+    Node* root = nullptr;
+    uint64_t lastLsn = 0;
+    CHECK(recoverTree(snapshotFile, logFile, root, lastLsn));
+
+    OperationLog log;
+    CHECK(log.open(logFile, lastLsn));
+    log.compact(buildSnapshotImage(root, log.lastLsn()), log.lastLsn(), snapshotFile, false);
+    uint64_t lsn = log.logAdd(MAKO, "Shortfin Mako", "");
+    CHECK(log.waitDurable(lsn));
+    applyLogRecord(root, LogRecord{lsn, LogOp::Add, MAKO, "Shortfin Mako", "", ""});
+    log.close();
+
+    std::vector<LogRecord> records;
+    CHECK(readLogRecords(logFile, records));
+    CHECK_EQ(records.size(), size_t(1));
+
+    Node* recovered = nullptr;
+    CHECK(recoverTree(snapshotFile, logFile, recovered, lastLsn));
+    CHECK_EQ(lastLsn, uint64_t(4));
+    CHECK(recovered != nullptr && contentHash(recovered) == contentHash(root));
+    deleteTree(recovered);
+    deleteTree(root);
+}
+
+int main() {
+    return runTests();
+}
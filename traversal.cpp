@@ -0,0 +1,109 @@
+#include "traversal.h"
+
+// --- ITERATOR ---
+
+PreOrderIterator::PreOrderIterator(Node* root) {
+    if (root) stack_.push_back({root, 0});
+}
+
+PreOrderIterator& PreOrderIterator::operator++() {
+    TraversalEntry current = stack_.back();
+    stack_.pop_back();
+
+    const auto& children = current.node->children;
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack_.push_back({*it, current.depth + 1});
+    }
+    return *this;
+}
+
+PostOrderIterator::PostOrderIterator(Node* root) {
+    if (root) descend(root);
+}
+
+/**
+ * @brief Pushes node and its first-child chain; the deepest one becomes current.
+ */
+void PostOrderIterator::descend(Node* node) {
+    while (true) {
+        stack_.push_back({node, 0});
+        if (node->children.empty()) break;
+        node = node->children.front();
+    }
+    current_ = {stack_.back().node, stack_.size() - 1};
+}
+
+PostOrderIterator& PostOrderIterator::operator++() {
+    stack_.pop_back();
+    if (stack_.empty()) return *this;
+
+    Frame& parent = stack_.back();
+    if (++parent.nextChild < parent.node->children.size()) {
+        descend(parent.node->children[parent.nextChild]);
+    } else {
+        current_ = {parent.node, stack_.size() - 1};
+    }
+    return *this;
+}
+
+LevelOrderIterator::LevelOrderIterator(Node* root) {
+    if (root) queue_.push_back({root, 0});
+}
+
+LevelOrderIterator& LevelOrderIterator::operator++() {
+    TraversalEntry current = queue_.front();
+    queue_.pop_front();
+    for (Node* child : current.node->children) {
+        queue_.push_back({child, current.depth + 1});
+    }
+    return *this;
+}
+
+// --- OUTPUT ---
+
+BufferedWriter::BufferedWriter(std::ostream& out, size_t capacity) : out_(out), capacity_(capacity) {
+    buffer_.reserve(capacity + 256);
+}
+
+void BufferedWriter::flush() {
+    if (buffer_.empty()) return;
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    out_.flush();
+    buffer_.clear();
+}
+
+void writeListingLine(BufferedWriter& out, Rank rank, std::string_view name, std::string_view commonName) {
+    out << rankName(rank) << ": " << name;
+    if (!commonName.empty()) {
+        out << " [" << commonName << "]";
+    }
+    out << '\n';
+}
+
+void writeDisplayLine(BufferedWriter& out, size_t depth, Rank rank, std::string_view name,
+                      std::string_view commonName, bool hasWikiLink) {
+    for (size_t i = 0; i < depth; ++i) {
+        out << (i == depth - 1 ? "  |--" : "  |  ");
+    }
+    out << "(" << rankName(rank) << ") " << name;
+
+    if (rank == Rank::Species) {
+        if (!commonName.empty()) {
+            out << " [" << commonName << "]";
+        }
+        if (hasWikiLink) {
+            out << " {W}";
+        }
+    }
+    out << '\n';
+}
+
+// --- SINK ---
+
+void ListingSink::accept(Node* node, size_t) {
+    writeListingLine(out_, node->rank, node->name.str(), nodeCommonName(node));
+}
+
+void TreeDisplaySink::accept(Node* node, size_t depth) {
+    writeDisplayLine(out_, baseDepth_ + depth, node->rank, node->name.str(), nodeCommonName(node), !nodeWikiLink(node).empty());
+}
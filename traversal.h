@@ -0,0 +1,180 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include "tree.h"
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// satu langkah traversal: node dan kedalamannya relatif terhadap root traversal
+struct TraversalEntry {
+    Node* node;
+    size_t depth;
+};
+
+// --- ITERATOR TRAVERSAL (stack/queue eksplisit, tanpa rekursi) ---
+
+class PreOrderIterator {
+public:
+    PreOrderIterator() = default;
+    explicit PreOrderIterator(Node* root);
+
+    const TraversalEntry& operator*() const { return stack_.back(); }
+    const TraversalEntry* operator->() const { return &stack_.back(); }
+    PreOrderIterator& operator++();
+    bool operator==(const PreOrderIterator& other) const { return stack_.empty() && other.stack_.empty(); }
+    bool operator!=(const PreOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::vector<TraversalEntry> stack_;
+};
+
+class PostOrderIterator {
+public:
+    PostOrderIterator() = default;
+    explicit PostOrderIterator(Node* root);
+
+    const TraversalEntry& operator*() const { return current_; }
+    const TraversalEntry* operator->() const { return &current_; }
+    PostOrderIterator& operator++();
+    bool operator==(const PostOrderIterator& other) const { return stack_.empty() && other.stack_.empty(); }
+    bool operator!=(const PostOrderIterator& other) const { return !(*this == other); }
+
+private:
+    struct Frame {
+        Node* node;
+        size_t nextChild;
+    };
+    void descend(Node* node);
+
+    std::vector<Frame> stack_;
+    TraversalEntry current_{nullptr, 0};
+};
+
+class LevelOrderIterator {
+public:
+    LevelOrderIterator() = default;
+    explicit LevelOrderIterator(Node* root);
+
+    const TraversalEntry& operator*() const { return queue_.front(); }
+    const TraversalEntry* operator->() const { return &queue_.front(); }
+    LevelOrderIterator& operator++();
+    bool operator==(const LevelOrderIterator& other) const { return queue_.empty() && other.queue_.empty(); }
+    bool operator!=(const LevelOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::deque<TraversalEntry> queue_;
+};
+
+template <typename Iterator>
+class TraversalRange {
+public:
+    explicit TraversalRange(Node* root) : root_(root) {}
+    Iterator begin() const { return Iterator(root_); }
+    Iterator end() const { return Iterator(); }
+
+private:
+    Node* root_;
+};
+
+// for (const TraversalEntry& entry : preOrder(root)) { ... }
+inline TraversalRange<PreOrderIterator> preOrder(Node* root) { return TraversalRange<PreOrderIterator>(root); }
+inline TraversalRange<PostOrderIterator> postOrder(Node* root) { return TraversalRange<PostOrderIterator>(root); }
+inline TraversalRange<LevelOrderIterator> levelOrder(Node* root) { return TraversalRange<LevelOrderIterator>(root); }
+
+// --- OUTPUT ---
+
+// Mengumpulkan teks dan menulisnya ke stream dalam potongan besar, bukan per token
+class BufferedWriter {
+public:
+    static const size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit BufferedWriter(std::ostream& out, size_t capacity = DEFAULT_CAPACITY);
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter& write(std::string_view text) {
+        buffer_.append(text.data(), text.size());
+        if (buffer_.size() >= capacity_) flush();
+        return *this;
+    }
+    BufferedWriter& operator<<(std::string_view text) { return write(text); }
+    BufferedWriter& operator<<(char c) { return write(std::string_view(&c, 1)); }
+    template <typename Integer, typename = typename std::enable_if<std::is_integral<Integer>::value>::type>
+    BufferedWriter& operator<<(Integer value) { return write(std::to_string(value)); }
+    void flush();
+
+private:
+    std::ostream& out_;
+    std::string buffer_;
+    size_t capacity_;
+};
+
+// --- SINK ---
+
+// penerima node hasil traversal
+class NodeSink {
+public:
+    virtual ~NodeSink() = default;
+    virtual void accept(Node* node, size_t depth) = 0;
+    virtual void finish() {}
+};
+
+// format "Level: name [common name]" seperti preOrderTraversal
+class ListingSink : public NodeSink {
+public:
+    explicit ListingSink(BufferedWriter& out) : out_(out) {}
+    void accept(Node* node, size_t depth) override;
+    void finish() override { out_.flush(); }
+
+private:
+    BufferedWriter& out_;
+};
+
+// format bertingkat seperti displayTree
+class TreeDisplaySink : public NodeSink {
+public:
+    explicit TreeDisplaySink(BufferedWriter& out, size_t baseDepth = 0) : out_(out), baseDepth_(baseDepth) {}
+    void accept(Node* node, size_t depth) override;
+    void finish() override { out_.flush(); }
+
+private:
+    BufferedWriter& out_;
+    size_t baseDepth_;
+};
+
+class CollectingSink : public NodeSink {
+public:
+    void accept(Node* node, size_t) override { nodes.push_back(node); }
+    std::vector<Node*> nodes;
+};
+
+class CountingSink : public NodeSink {
+public:
+    void accept(Node* node, size_t) override {
+        ++total;
+        ++perRank[static_cast<size_t>(node->rank)];
+    }
+    size_t total = 0;
+    size_t perRank[RANK_COUNT] = {};   // index = Rank
+};
+
+template <typename Range>
+void runTraversal(const Range& range, NodeSink& sink) {
+    for (const TraversalEntry& entry : range) {
+        sink.accept(entry.node, entry.depth);
+    }
+    sink.finish();
+}
+
+// Baris teks yang sama dengan output traversal/displayTree, dipakai juga oleh snapshot
+void writeListingLine(BufferedWriter& out, Rank rank, std::string_view name, std::string_view commonName);
+void writeDisplayLine(BufferedWriter& out, size_t depth, Rank rank, std::string_view name,
+                      std::string_view commonName, bool hasWikiLink);
+
+#endif
@@ -1,275 +1,902 @@
 #include "tree.h"
+#include "traversal.h"
+#include "metrics.h"
 #include <algorithm> // For std::transform, std::remove
-#include <cctype>    // For ::tolower
 #include <iostream>
-#include <queue>     // Diperlukan untuk Level Order Traversal
+#include <array>
+#include <functional>
+#include <bitset>
+#include <new>
 
 /**
  * @brief Helper function to convert a string to lowercase for case-insensitive comparison.
- * DIDEFINISIKAN HANYA DI SINI.
+ * DIDEFINISIKAN HANYA DI SINI. Perbandingan nama di tree memakai equalsFolded/hashFolded (fold.h).
  */
 std::string toLower(const std::string& str) {
-    std::string data = str;
-    std::transform(data.begin(), data.end(), data.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
+    std::string data;
+    foldAssign(data, str);
     return data;
 }
 
+// --- STRING POOL & NODE ARENA ---
+
+InternedName StringPool::intern(const std::string& str) {
+    return InternedName(&*strings_.insert(str).first);
+}
+
+/**
+ * @brief Bucket array, one hash node per string and the characters of strings too long for SSO.
+ */
+size_t StringPool::bytes() const {
+    static const size_t inlineCapacity = std::string().capacity();
+    size_t total = strings_.bucket_count() * sizeof(void*) + strings_.size() * (sizeof(std::string) + 2 * sizeof(void*));
+    for (const std::string& str : strings_) {
+        if (str.capacity() > inlineCapacity) total += str.capacity() + 1;
+    }
+    return total;
+}
+
+// satu node per cache line (vector versi debug, mis. MSVC, boleh membuatnya lebih besar)
+static_assert(sizeof(Node) == 64 || sizeof(std::vector<Node*>) > 3 * sizeof(void*), "Node no longer fits in one cache line");
+
+struct NodeArena::Chunk {
+    static const uint32_t NODES = 1024;
+
+    alignas(Node) unsigned char slots[NODES * sizeof(Node)];
+    std::bitset<NODES> live;
+
+    Node* at(uint32_t slot) { return reinterpret_cast<Node*>(slots) + slot; }
+};
+
+/**
+ * @brief Constructs a node in the first free slot, reusing ids released by deletes.
+ */
+Node* NodeArena::allocate() {
+    uint32_t id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        id = nextId_++;
+        if (id / Chunk::NODES == chunks_.size()) {
+            chunks_.push_back(new Chunk());
+        }
+    }
+
+    Chunk* chunk = chunks_[id / Chunk::NODES];
+    uint32_t slot = id % Chunk::NODES;
+    Node* node = new (chunk->at(slot)) Node();
+    chunk->live.set(slot);
+    node->id = id;
+    ++live_;
+    return node;
+}
+
+void NodeArena::release(Node* node) {
+    Chunk* chunk = chunks_[node->id / Chunk::NODES];
+    chunk->live.reset(node->id % Chunk::NODES);
+    freeIds_.push_back(node->id);
+    node->~Node();
+    --live_;
+}
+
+size_t NodeArena::reservedBytes() const {
+    return chunks_.size() * sizeof(Chunk) + chunks_.capacity() * sizeof(Chunk*) + freeIds_.capacity() * sizeof(uint32_t);
+}
+
+/**
+ * @brief Destroys every live node chunk by chunk, without walking the tree.
+ */
+NodeArena::~NodeArena() {
+    for (Chunk* chunk : chunks_) {
+        for (uint32_t slot = 0; slot < Chunk::NODES; ++slot) {
+            if (chunk->live.test(slot)) chunk->at(slot)->~Node();
+        }
+        delete chunk;
+    }
+}
+
+// --- CONTENT HASH ---
+
+// finalizer splitmix64: setiap bit input mempengaruhi semua bit output
+static uint64_t mixHash(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Hash of the node's own content: name (case-insensitive, like every lookup), rank,
+ *        common name and wiki link. Children are added by shiftContentHash.
+ */
+static uint64_t ownContentHash(const Node* node) {
+    std::hash<std::string_view> text;
+    uint64_t hash = mixHash(hashFolded(node->name.str()) + static_cast<uint64_t>(node->rank));
+    hash = mixHash(hash ^ text(nodeCommonName(node)));
+    return mixHash(hash ^ text(nodeWikiLink(node)));
+}
+
+/**
+ * @brief Adds delta to the content hash of node. A parent holds the sum of its children's
+ *        mixed hashes, so the change is re-mixed at every level on the way up.
+ */
+static void shiftContentHash(Node* node, uint64_t delta) {
+    while (node != nullptr && delta != 0) {
+        uint64_t& hash = node->ctx->subtreeStats[node->id].contentHash;
+        uint64_t before = hash;
+        hash += delta;
+        delta = mixHash(hash) - mixHash(before);
+        node = node->parent;
+    }
+}
+
 /**
- * @brief Creates a new tree node.
+ * @brief Creates a new tree node inside the tree's arena.
  */
-Node* createNode(const std::string& name, const std::string& level) {
-    Node* newNode = new Node();
-    newNode->name = name;
-    newNode->level = level;
-    newNode->commonName = "";   
-    newNode->wikiLink = "";     
+Node* createNode(TreeContext* ctx, const std::string& name, Rank rank) {
+    Node* newNode = ctx->nodes.allocate();
+    newNode->name = ctx->strings.intern(name);
+    newNode->rank = rank;
+    newNode->ctx = ctx;
+    if (ctx->subtreeStats.size() < ctx->nodes.idLimit()) ctx->subtreeStats.resize(ctx->nodes.idLimit());
+    SubtreeStats& stats = ctx->subtreeStats[newNode->id];
+    stats = SubtreeStats();
+    stats.perRank[static_cast<size_t>(rank)] = 1;
+    stats.contentHash = ownContentHash(newNode);
     return newNode;
 }
 
 /**
- * @brief Recursively finds a child node with a specific name.
+ * @brief Drops the node's metadata and returns its slot to the arena; the node must already be unindexed.
  */
-Node* findChild(Node* parent, const std::string& name) {
-    std::string lowerName = toLower(name);
-    for (Node* child : parent->children) {
-        if (toLower(child->name) == lowerName) {
-            return child;
+static void releaseNode(Node* node) {
+    TreeContext* ctx = node->ctx;
+    ctx->commonNames.clear(node->id);
+    ctx->wikiLinks.clear(node->id);
+    ctx->nodes.release(node);
+}
+
+// --- METADATA COLUMNS ---
+
+void MetadataColumn::ensure(uint32_t id) {
+    if (id >= values_.size()) {
+        values_.resize(id + 1);
+        owned_.resize(id + 1);
+    }
+}
+
+void MetadataColumn::set(uint32_t id, std::string_view value) {
+    if (value.empty() && id >= values_.size()) return;
+    ensure(id);
+    std::unique_ptr<char[]> text;
+    if (!value.empty()) {
+        text.reset(new char[value.size()]);
+        std::copy(value.begin(), value.end(), text.get());
+    }
+    values_[id] = std::string_view(text.get(), value.size());
+    owned_[id] = std::move(text);
+}
+
+void MetadataColumn::borrow(uint32_t id, std::string_view value) {
+    if (value.empty() && id >= values_.size()) return;
+    ensure(id);
+    values_[id] = value;
+    owned_[id].reset();
+}
+
+void MetadataColumn::clear(uint32_t id) {
+    if (id >= values_.size()) return;
+    values_[id] = std::string_view();
+    owned_[id].reset();
+}
+
+size_t MetadataColumn::bytes() const {
+    size_t total = values_.capacity() * sizeof(std::string_view) + owned_.capacity() * sizeof(std::unique_ptr<char[]>);
+    for (size_t id = 0; id < owned_.size(); ++id) {
+        if (owned_[id]) total += values_[id].size();
+    }
+    return total;
+}
+
+// --- SUBTREE AGGREGATES ---
+
+/**
+ * @brief Adds a subtree's totals to node and every ancestor above it.
+ */
+static void addToAncestors(Node* node, SubtreeStats delta) {
+    for (; node != nullptr; node = node->parent) {
+        SubtreeStats& stats = node->ctx->subtreeStats[node->id];
+        for (size_t rank = 0; rank < RANK_COUNT; ++rank) stats.perRank[rank] += delta.perRank[rank];
+        stats.linkedSpecies += delta.linkedSpecies;
+    }
+}
+
+static void removeFromAncestors(Node* node, SubtreeStats delta) {
+    for (; node != nullptr; node = node->parent) {
+        SubtreeStats& stats = node->ctx->subtreeStats[node->id];
+        for (size_t rank = 0; rank < RANK_COUNT; ++rank) stats.perRank[rank] -= delta.perRank[rank];
+        stats.linkedSpecies -= delta.linkedSpecies;
+    }
+}
+
+/**
+ * @brief Sets a node's wiki link and keeps linkedSpecies of the node and its ancestors in step.
+ */
+static void assignWikiLink(Node* node, std::string_view wikiLink, TextStorage storage = TextStorage::Copy) {
+    bool wasLinked = node->rank == Rank::Species && !nodeWikiLink(node).empty();
+    if (storage == TextStorage::Borrow) {
+        node->ctx->wikiLinks.borrow(node->id, wikiLink);
+    } else {
+        node->ctx->wikiLinks.set(node->id, wikiLink);
+    }
+    bool linked = node->rank == Rank::Species && !wikiLink.empty();
+    ++node->ctx->revision;
+    if (linked == wasLinked) return;
+
+    SubtreeStats delta;
+    delta.linkedSpecies = 1;
+    if (linked) {
+        addToAncestors(node, delta);
+    } else {
+        removeFromAncestors(node, delta);
+    }
+}
+
+/**
+ * @brief Sets common name and wiki link together and moves the content hash along.
+ */
+static void assignMetadata(Node* node, std::string_view commonName, std::string_view wikiLink,
+                           TextStorage storage = TextStorage::Copy) {
+    // daun: hash subtree sama dengan hash isinya sendiri, tidak perlu dihitung ulang
+    uint64_t before = node->children.empty() ? nodeSubtreeStats(node).contentHash : ownContentHash(node);
+    if (storage == TextStorage::Borrow) {
+        node->ctx->commonNames.borrow(node->id, commonName);
+    } else {
+        node->ctx->commonNames.set(node->id, commonName);
+    }
+    assignWikiLink(node, wikiLink, storage);
+    shiftContentHash(node, ownContentHash(node) - before);
+}
+
+/**
+ * @brief Recomputes every aggregate bottom-up; a post-order walk finishes all children of a
+ *        node (one depth deeper) right before the node itself.
+ */
+bool checkSubtreeStats(const Node* root) {
+    if (root == nullptr) return true;
+
+    std::vector<SubtreeStats> pending;   // jumlah anak yang sudah selesai, per kedalaman
+    for (const TraversalEntry& entry : postOrder(const_cast<Node*>(root))) {
+        const Node* node = entry.node;
+        if (pending.size() < entry.depth + 2) pending.resize(entry.depth + 2);
+
+        SubtreeStats expected = pending[entry.depth + 1];
+        pending[entry.depth + 1] = SubtreeStats();
+        ++expected.perRank[static_cast<size_t>(node->rank)];
+        if (node->rank == Rank::Species && !nodeWikiLink(node).empty()) ++expected.linkedSpecies;
+        expected.contentHash += ownContentHash(node);
+
+        const SubtreeStats& stored = nodeSubtreeStats(node);
+        bool same = expected.linkedSpecies == stored.linkedSpecies && expected.contentHash == stored.contentHash;
+        for (size_t rank = 0; rank < RANK_COUNT; ++rank) {
+            same = same && expected.perRank[rank] == stored.perRank[rank];
+        }
+        if (!same) {
+            std::cerr << "[CHECK] Subtree stats of " << rankName(node->rank) << " '" << node->name << "' are stale: "
+                      << "species " << speciesCount(node) << " (expected " << expected.perRank[static_cast<size_t>(Rank::Species)]
+                      << "), linked " << stored.linkedSpecies << " (expected " << expected.linkedSpecies << ")"
+                      << (expected.contentHash != stored.contentHash ? ", content hash differs" : "") << ".\n";
+            return false;
         }
+
+        SubtreeStats& parent = pending[entry.depth];
+        for (size_t rank = 0; rank < RANK_COUNT; ++rank) parent.perRank[rank] += expected.perRank[rank];
+        parent.linkedSpecies += expected.linkedSpecies;
+        parent.contentHash += mixHash(expected.contentHash);
+    }
+    return true;
+}
+
+// --- CHILD INDEX ---
+
+Node* ChildIndex::find(const std::vector<Node*>& children, std::string_view name) const {
+    if (wide) {
+        auto it = wide->find(name);
+        return it == wide->end() ? nullptr : it->second;
+    }
+    for (Node* child : children) {
+        if (equalsFolded(child->name.str(), name)) return child;
     }
     return nullptr;
 }
 
 /**
- * @brief Inserts a full taxonomic path (Class down to Species) into the tree.
+ * @brief Indexes a child; the first child registered under a name wins, like the linear scan.
  */
-Node* addSpeciesPath(Node* root, const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink) {
-    if (path.size() != REQUIRED_TAX_LEVELS) {
-        std::cerr << "Internal Error: Path size mismatch in addSpeciesPath.\n";
-        return root;
+void ChildIndex::insert(const std::vector<Node*>& children, Node* child) {
+    if (wide) {
+        wide->emplace(child->name.str(), child);
+        return;
     }
 
+    if (children.size() > SMALL_LIMIT) {
+        wide = new std::unordered_map<std::string_view, Node*, FoldedHash, FoldedEqual>();
+        for (Node* indexed : children) {
+            wide->emplace(indexed->name.str(), indexed);
+        }
+    }
+}
+
+void ChildIndex::erase(const Node* child) {
+    if (wide == nullptr) return;
+    auto it = wide->find(child->name.str());
+    if (it != wide->end() && it->second == child) wide->erase(it);
+}
+
+/**
+ * @brief Re-indexes children whose name lost its entry. Only hand-built trees have duplicate
+ *        names, so this is a size comparison in practice.
+ */
+void ChildIndex::restore(const std::vector<Node*>& children) {
+    if (wide == nullptr || wide->size() == children.size()) return;
+    for (Node* child : children) {
+        wide->emplace(child->name.str(), child);
+    }
+}
+
+/**
+ * @brief Unlinks a child from its parent's children vector and child index.
+ */
+static void detachChild(Node* child) {
+    Node* parent = child->parent;
+    auto& siblings = parent->children;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), child), siblings.end());
+
+    parent->childIndex.erase(child);
+    parent->childIndex.restore(siblings);
+    ++parent->ctx->revision;
+    removeFromAncestors(parent, nodeSubtreeStats(child));
+    shiftContentHash(parent, 0 - mixHash(nodeSubtreeStats(child).contentHash));
+}
+
+// --- NAME INDEX ---
+
+/**
+ * @brief Registers a node under its folded taxonomic name and common name.
+ */
+static void indexNode(Node* node) {
+    auto& names = node->ctx->nameIndex;
+    names[node->name.str()].push_back(node);
+
+    std::string_view commonName = nodeCommonName(node);
+    if (!commonName.empty() && !equalsFolded(commonName, node->name.str())) {
+        names[commonName].push_back(node);
+    }
+}
+
+/**
+ * @brief Removes node from the bucket of key. If the bucket's key points into this
+ *        node's strings, it is re-pointed at a remaining node so it never dangles.
+ */
+static void unindexKey(TreeContext* ctx, std::string_view key, Node* node) {
+    auto& names = ctx->nameIndex;
+    auto it = names.find(key);
+    if (it == names.end()) return;
+
+    auto& bucket = it->second;
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), node), bucket.end());
+    if (bucket.empty()) {
+        names.erase(it);
+        return;
+    }
+
+    if (it->first.data() == key.data()) {
+        Node* owner = bucket.front();
+        std::string_view replacement = equalsFolded(owner->name.str(), key) ? std::string_view(owner->name.str())
+                                                                          : nodeCommonName(owner);
+        auto entry = names.extract(it);
+        entry.key() = replacement;
+        names.insert(std::move(entry));
+    }
+}
+
+/**
+ * @brief Removes every index entry that points at the node.
+ */
+static void unindexNode(Node* node) {
+    unindexKey(node->ctx, node->name.str(), node);
+    std::string_view commonName = nodeCommonName(node);
+    if (!commonName.empty() && !equalsFolded(commonName, node->name.str())) {
+        unindexKey(node->ctx, commonName, node);
+    }
+}
+
+/**
+ * @brief Links a child under its parent and makes it visible to the name index.
+ */
+static void attachChild(Node* parent, Node* child) {
+    child->parent = parent;
+    ++parent->ctx->revision;
+    parent->children.push_back(child);
+    parent->childIndex.insert(parent->children, child);
+    addToAncestors(parent, nodeSubtreeStats(child));
+    shiftContentHash(parent, mixHash(nodeSubtreeStats(child).contentHash));
+    indexNode(child);
+}
+
+/**
+ * @brief Appends a fully described child without a duplicate check; see tree.h.
+ */
+Node* appendChild(Node* parent, const std::string& name, Rank rank, std::string_view commonName, std::string_view wikiLink,
+                  TextStorage storage) {
+    Node* node = createNode(parent ? parent->ctx : new TreeContext(), name, rank);
+    assignMetadata(node, commonName, wikiLink, storage);
+
+    if (parent) {
+        attachChild(parent, node);
+    } else {
+        indexNode(node);
+    }
+    return node;
+}
+
+static bool isInSubtree(const Node* node, const Node* subtreeRoot) {
+    for (; node != nullptr; node = node->parent) {
+        if (node == subtreeRoot) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns true if a is visited before b in a pre-order walk of their tree. Nodes of
+ *        different trees are ordered by their roots' addresses, so this stays a strict weak
+ *        ordering (usable with std::sort) even for a mix of trees.
+ */
+bool precedesInPreorder(const Node* a, const Node* b) {
+    if (a == b) return false;
+
+    // rank sama dengan kedalaman, jadi path ke root muat di array tetap (tanpa alokasi)
+    std::array<const Node*, RANK_COUNT> pathA, pathB;
+    size_t depthA = 0, depthB = 0;
+    for (const Node* n = a; n && depthA < RANK_COUNT; n = n->parent) pathA[depthA++] = n;
+    for (const Node* n = b; n && depthB < RANK_COUNT; n = n->parent) pathB[depthB++] = n;
+
+    // tanpa root yang sama (mis. dua shard Forest) tidak ada cabang yang bisa dibandingkan
+    if (pathA[depthA - 1] != pathB[depthB - 1]) {
+        return std::less<const Node*>()(pathA[depthA - 1], pathB[depthB - 1]);
+    }
+
+    // jalan turun dari root sampai kedua path berpisah
+    while (depthA > 0 && depthB > 0 && pathA[depthA - 1] == pathB[depthB - 1]) {
+        --depthA;
+        --depthB;
+    }
+    if (depthA == 0) return true;   // a adalah ancestor dari b
+    if (depthB == 0) return false;
+
+    const Node* branchA = pathA[depthA - 1];
+    const Node* branchB = pathB[depthB - 1];
+    const auto& siblings = branchA->parent->children;
+    return std::find(siblings.begin(), siblings.end(), branchA) < std::find(siblings.begin(), siblings.end(), branchB);
+}
+
+/**
+ * @brief Looks up all nodes under subtreeRoot whose taxonomic or common name matches, in no particular order.
+ */
+static std::vector<Node*> lookupName(Node* subtreeRoot, const std::string& name) {
+    std::vector<Node*> matches;
+    auto it = subtreeRoot->ctx->nameIndex.find(name);
+    if (it == subtreeRoot->ctx->nameIndex.end()) return matches;
+
+    for (Node* node : it->second) {
+        if (subtreeRoot->parent == nullptr || isInSubtree(node, subtreeRoot)) {
+            matches.push_back(node);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Finds a direct child by name (case-insensitive) through the parent's child index.
+ */
+Node* findChild(Node* parent, const std::string& name) {
+    return parent->childIndex.find(parent->children, name);
+}
+
+/**
+ * @brief Resolves a full name path starting at root in O(depth).
+ */
+Node* findPath(Node* root, const std::vector<std::string>& path) {
+    METRIC_SCOPE(Operation::FindPath);
+    if (root == nullptr || path.empty()) return nullptr;
+
+    if (!equalsFolded(root->name.str(), path[0])) return nullptr;
+
+    Node* current = root;
+    size_t level = 1;
+    for (; level < path.size() && current != nullptr; ++level) {
+        current = findChild(current, path[level]);
+    }
+    METRIC_VISITED(level);
+    return current;
+}
+
+/**
+ * @brief Shared insert routine behind addSpeciesPath and insertSpeciesRecord.
+ * Names are only copied when a new node is created; log output is optional.
+ */
+static InsertResult insertPath(Node*& root, const std::string_view* path, std::string_view commonName, std::string_view wikiLink, bool verbose) {
     Node* currentNode = root;
-    std::string newClassNameLower = toLower(path[0]);
+    InsertResult result = InsertResult::Unchanged;
     
-    for (size_t i = 0; i < path.size(); ++i) {
-        const std::string& name = path[i];
-        std::string level = TAX_LEVELS[i];
+    for (size_t i = 0; i < REQUIRED_TAX_LEVELS; ++i) {
+        std::string_view name = path[i];
+        const std::string& level = TAX_LEVELS[i];
+        Rank rank = static_cast<Rank>(i);
+        bool isSpecies = (i == REQUIRED_TAX_LEVELS - 1);
 
         if (i == 0) {
             if (currentNode == nullptr) {
-                currentNode = createNode(name, level);
+                currentNode = createNode(new TreeContext(), std::string(name), rank);
+                indexNode(currentNode);
                 root = currentNode;
-            } else if (toLower(currentNode->name) != newClassNameLower) {
-                std::cerr << "Error: The tree already has a Class: " << currentNode->name 
-                          << ". All shark species must belong to the same Class.\n";
-                return root;
+            } else if (!equalsFolded(currentNode->name.str(), name)) {
+                if (verbose) {
+                    std::cerr << "Error: The tree already has a Class: " << currentNode->name 
+                              << ". All shark species must belong to the same Class.\n";
+                }
+                return InsertResult::Rejected;
             }
-        } else {
-            Node* existingChild = findChild(currentNode, name);
+            continue;
+        }
+
+        Node* existingChild = currentNode->childIndex.find(currentNode->children, name);
+        
+        if (existingChild) {
+            currentNode = existingChild;
             
-            if (existingChild) {
-                currentNode = existingChild;
-                
-                if (i == path.size() - 1) {
-                     // Update existing species details
-                     if (existingChild->commonName != commonName || existingChild->wikiLink != wikiLink) {
-                         existingChild->commonName = commonName;
-                         existingChild->wikiLink = wikiLink;
+            if (isSpecies) {
+                 // Update existing species details
+                 if (nodeCommonName(existingChild) != commonName || nodeWikiLink(existingChild) != wikiLink) {
+                     unindexNode(existingChild);
+                     assignMetadata(existingChild, commonName, wikiLink);
+                     indexNode(existingChild);
+                     result = InsertResult::Updated;
+                     if (verbose) {
                          std::cout << "[INFO] Species '" << name << "' already exists. Updating its details.\n";
                      }
+                 }
+            }
+        } else {
+            Node* newNode = createNode(currentNode->ctx, std::string(name), rank);
+            
+            if (isSpecies) {
+                assignMetadata(newNode, commonName, wikiLink);
+                attachChild(currentNode, newNode);
+                result = InsertResult::Added;
+                if (verbose) {
+                    std::cout << "--> Successfully added new species: " << commonName << " (" << name << ")\n";
                 }
             } else {
-                Node* newNode = createNode(name, level);
-                currentNode->children.push_back(newNode);
-                
-                if (i == path.size() - 1) {
-                    newNode->commonName = commonName;
-                    newNode->wikiLink = wikiLink; 
-                    std::cout << "--> Successfully added new species: " << commonName << " (" << name << ")\n";
-                } else {
+                attachChild(currentNode, newNode);
+                if (verbose) {
                     std::cout << "--> Inserting new " << level << ": " << name << "\n";
                 }
-                
-                currentNode = newNode;
             }
+            
+            currentNode = newNode;
         }
     }
     
+    return result;
+}
+
+/**
+ * @brief Inserts a full taxonomic path (Class down to Species) into the tree.
+ */
+Node* addSpeciesPath(Node* root, const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink) {
+    METRIC_SCOPE(Operation::AddSpecies);
+    if (path.size() != REQUIRED_TAX_LEVELS) {
+        std::cerr << "Internal Error: Path size mismatch in addSpeciesPath.\n";
+        return root;
+    }
+
+    std::vector<std::string_view> names(path.begin(), path.end());
+    insertPath(root, names.data(), commonName, wikiLink, true);
     return root;
 }
 
+/**
+ * @brief Silent insert used by bulk loaders; see tree.h.
+ */
+InsertResult insertSpeciesRecord(Node*& root, const std::vector<std::string_view>& path, std::string_view commonName, std::string_view wikiLink) {
+    METRIC_SCOPE(Operation::InsertRecord);
+    if (path.size() != REQUIRED_TAX_LEVELS) {
+        return InsertResult::Rejected;
+    }
+    return insertPath(root, path.data(), commonName, wikiLink, false);
+}
+
 
 /**
- * @brief Recursively searches the tree for a node with a matching taxonomic OR common name.
+ * @brief Finds the node with a matching taxonomic OR common name through the name index.
+ * When several nodes match, the one a pre-order walk would reach first is returned.
  */
 Node* searchNode(Node* root, const std::string& name) {
+    METRIC_SCOPE(Operation::Search);
     if (root == nullptr) {
         return nullptr;
     }
-    std::string lowerName = toLower(name);
 
-    if (toLower(root->name) == lowerName) {
-        return root;
-    }
-    
-    if (!root->commonName.empty() && toLower(root->commonName) == lowerName) {
-        return root;
+    // bucket name index dibaca di tempat, tanpa menyalin kandidat
+    auto it = root->ctx->nameIndex.find(name);
+    if (it == root->ctx->nameIndex.end()) {
+        METRIC_VISITED(0);
+        return nullptr;
     }
 
-    for (Node* child : root->children) {
-        Node* result = searchNode(child, name);
-        if (result != nullptr) {
-            return result;
+    Node* best = nullptr;
+    size_t candidates = 0;
+    for (Node* node : it->second) {
+        if (root->parent != nullptr && !isInSubtree(node, root)) continue;
+        ++candidates;
+        if (best == nullptr || precedesInPreorder(node, best)) {
+            best = node;
         }
     }
-
-    return nullptr;
+    METRIC_VISITED(candidates);
+    return best;
 }
 
 // --- CRUD: UPDATE IMPLEMENTATION ---
-/**
- * @brief Updates the common name and Wikipedia link of a specific Species node.
- */
-bool updateSpecies(Node* speciesNode, const std::string& newCommonName, const std::string& newWikiLink) {
-    if (speciesNode == nullptr || speciesNode->level != "Species") {
-        std::cerr << "[ERROR] Cannot update node details. Must be a valid Species node.\n";
+static bool updateDetails(Node* speciesNode, std::string_view newCommonName, std::string_view newWikiLink, bool verbose) {
+    if (speciesNode == nullptr || speciesNode->rank != Rank::Species) {
+        if (verbose) {
+            std::cerr << "[ERROR] Cannot update node details. Must be a valid Species node.\n";
+        }
         return false;
     }
 
-    speciesNode->commonName = newCommonName;
-    speciesNode->wikiLink = newWikiLink;
+    unindexNode(speciesNode);
+    assignMetadata(speciesNode, newCommonName, newWikiLink);
+    indexNode(speciesNode);
     
-    std::cout << "[SUCCESS] Species '" << speciesNode->name << "' updated.\n";
+    if (verbose) {
+        std::cout << "[SUCCESS] Species '" << speciesNode->name << "' updated.\n";
+    }
     
     return true;
 }
 
-// --- CRUD: DELETE IMPLEMENTATION ---
 /**
- * @brief Recursively searches for and deletes a specific Species node by its name.
+ * @brief Updates the common name and Wikipedia link of a specific Species node.
  */
-Node* deleteSpecies(Node* root, const std::string& speciesName, Node* parent) {
-    if (root == nullptr) {
-        return nullptr;
-    }
+bool updateSpecies(Node* speciesNode, const std::string& newCommonName, const std::string& newWikiLink) {
+    METRIC_SCOPE(Operation::Update);
+    return updateDetails(speciesNode, newCommonName, newWikiLink, true);
+}
 
-    std::string lowerSpeciesName = toLower(speciesName);
-    
-    if (root->level == "Species" && 
-        (toLower(root->name) == lowerSpeciesName || toLower(root->commonName) == lowerSpeciesName)) {
-        
-        if (parent == nullptr) {
-            std::cerr << "[ERROR] Cannot delete the absolute root node (" << root->name << ").\n";
-            return root;
-        }
+bool updateSpeciesRecord(Node* speciesNode, std::string_view newCommonName, std::string_view newWikiLink) {
+    METRIC_SCOPE(Operation::Update);
+    return updateDetails(speciesNode, newCommonName, newWikiLink, false);
+}
 
-        // Remove the pointer from the parent's children vector
-        auto& children = parent->children;
-        auto it = std::remove(children.begin(), children.end(), root);
-        children.erase(it, children.end());
-        
-        std::cout << "[SUCCESS] Species '" << root->commonName << " (" << root->name << ")' deleted.\n";
-        delete root;
-        
-        return parent; 
-    }
+// --- CRUD: DELETE IMPLEMENTATION ---
 
-    // Pass the current root as the parent for the next level
-    for (Node* child : root->children) {
-        deleteSpecies(child, speciesName, root); 
+/**
+ * @brief Unlinks every marked child of parent with a single compaction of its children vector.
+ */
+static void detachMarkedChildren(Node* parent, const std::vector<Node*>& removed, const std::unordered_set<const Node*>& marked) {
+    auto& children = parent->children;
+    ++parent->ctx->revision;
+    for (Node* child : removed) {
+        parent->childIndex.erase(child);
+        removeFromAncestors(parent, nodeSubtreeStats(child));
+        shiftContentHash(parent, 0 - mixHash(nodeSubtreeStats(child).contentHash));
+    }
+    if (removed.size() == 1) {
+        children.erase(std::find(children.begin(), children.end(), removed.front()));
+    } else {
+        children.erase(std::remove_if(children.begin(), children.end(), [&marked](Node* child) { return marked.count(child) != 0; }),
+                       children.end());
     }
-    
-    return root; 
-}
 
+    parent->childIndex.restore(children);
+}
 
 /**
- * @brief Displays the tree structure using indentation.
+ * @brief Shared delete routine behind deleteSpecies, deleteSpeciesRecord and deleteSpeciesBatch.
+ * Removes the species level by level: each affected parent is compacted once, then parents
+ * left without children are removed in the next round. result becomes the parent of root
+ * if root itself was deleted.
  */
-void displayTree(Node* root, int depth) {
-    if (!root) return;
-
-    for (int i = 0; i < depth; ++i) {
-        std::cout << (i == depth - 1 ? "  |--" : "  |  ");
+static size_t removeSpeciesNodes(Node* root, std::vector<Node*> targets, bool verbose, Node*& result) {
+    result = root;
+    // ukurannya mengikuti jumlah target, bukan ukuran tree
+    std::unordered_set<const Node*> marked;                   // akan dihapus
+    std::unordered_map<const Node*, size_t> parentSlot;       // parent -> index di parents
+
+    std::vector<Node*> level;
+    for (Node* target : targets) {
+        if (target->rank != Rank::Species || marked.count(target)) continue;
+
+        if (target->parent == nullptr) {
+            if (verbose) {
+                std::cerr << "[ERROR] Cannot delete the absolute root node (" << target->name << ").\n";
+            }
+            continue;
+        }
+        marked.insert(target);
+        level.push_back(target);
+    }
+    // pesan ditulis dalam urutan pre-order, tidak bergantung pada urutan di name index
+    if (verbose) {
+        std::sort(level.begin(), level.end(), precedesInPreorder);
     }
+    size_t removed = level.size();
 
-    std::cout << "(" << root->level << ") " << root->name;
-    
-    if (root->level == "Species") {
-        if (!root->commonName.empty()) {
-            std::cout << " [" << root->commonName << "]";
+    for (Node* target : level) {
+        if (target == root) {
+            result = target->parent;
         }
-        if (!root->wikiLink.empty()) { 
-            std::cout << " {W}"; 
+        if (verbose) {
+            std::cout << "[SUCCESS] Species '" << nodeCommonName(target) << " (" << target->name << ")' deleted.\n";
         }
     }
-    std::cout << "\n";
 
-    for (Node* child : root->children) {
-        displayTree(child, depth + 1);
+    // parent yang terdampak beserta anak-anaknya yang dihapus di putaran ini
+    std::vector<std::pair<Node*, std::vector<Node*>>> parents;
+    while (!level.empty()) {
+        parents.clear();
+        parentSlot.clear();
+        for (Node* node : level) {
+            auto inserted = parentSlot.emplace(node->parent, parents.size());
+            if (inserted.second) parents.push_back({node->parent, {}});
+            parents[inserted.first->second].second.push_back(node);
+        }
+        for (const auto& entry : parents) {
+            detachMarkedChildren(entry.first, entry.second, marked);
+        }
+        for (Node* node : level) {
+            unindexNode(node);
+            releaseNode(node);
+        }
+
+        // ancestor yang sekarang kosong dihapus di putaran berikutnya
+        level.clear();
+        for (const auto& entry : parents) {
+            Node* parent = entry.first;
+            if (parent->children.empty() && parent != root && parent->parent != nullptr && isInSubtree(parent, root)) {
+                if (verbose) {
+                    std::cout << "[INFO] Empty " << rankName(parent->rank) << " '" << parent->name << "' removed.\n";
+                }
+                marked.insert(parent);
+                level.push_back(parent);
+            }
+        }
     }
+    return removed;
 }
 
 /**
- * @brief Cleans up all dynamically allocated memory in the tree.
+ * @brief Deletes every Species node under root whose taxonomic or common name matches.
  */
-void deleteTree(Node* root) {
-    if (!root) return;
-    for (Node* child : root->children) {
-        deleteTree(child);
+Node* deleteSpecies(Node* root, const std::string& speciesName, Node* parent) {
+    METRIC_SCOPE(Operation::Delete);
+    if (root == nullptr) {
+        return nullptr;
     }
-    delete root;
-}
+    (void)parent; // parent sekarang disimpan di setiap node
 
-// --- TRAVERSAL IMPLEMENTATIONS ---
+    Node* result = root;
+    removeSpeciesNodes(root, lookupName(root, speciesName), true, result);
+    return result; 
+}
 
-void preOrderTraversal(Node* root) {
-    if (!root) return;
+size_t deleteSpeciesRecord(Node* root, const std::string& speciesName) {
+    METRIC_SCOPE(Operation::Delete);
+    if (root == nullptr) {
+        return 0;
+    }
+    Node* result = root;
+    return removeSpeciesNodes(root, lookupName(root, speciesName), false, result);
+}
 
-    std::cout << root->level << ": " << root->name;
-    if (!root->commonName.empty()) {
-        std::cout << " [" << root->commonName << "]";
+/**
+ * @brief Deletes the species of several names in one pass; see tree.h.
+ */
+size_t deleteSpeciesBatch(Node* root, const std::vector<std::string>& speciesNames, std::vector<size_t>* removedPerName) {
+    METRIC_SCOPE(Operation::DeleteBatch);
+    if (removedPerName) removedPerName->assign(speciesNames.size(), 0);
+    if (root == nullptr) {
+        return 0;
     }
-    std::cout << "\n";
+    // setiap species dihitung untuk nama pertama yang cocok, seperti delete satu per satu
+    std::vector<Node*> targets;
+    std::unordered_set<const Node*> taken;
+    for (size_t i = 0; i < speciesNames.size(); ++i) {
+        for (Node* match : lookupName(root, speciesNames[i])) {
+            if (match->rank != Rank::Species || match->parent == nullptr || !taken.insert(match).second) continue;
+            targets.push_back(match);
+            if (removedPerName) ++(*removedPerName)[i];
+        }
+    }
+    Node* result = root;
+    return removeSpeciesNodes(root, std::move(targets), false, result);
+}
 
-    for (Node* child : root->children) {
-        preOrderTraversal(child);
+/**
+ * @brief Collects the names from the tree root down to node, i.e. the path addSpeciesPath takes.
+ */
+std::vector<std::string> nodePath(const Node* node) {
+    std::vector<std::string> path;
+    for (; node != nullptr; node = node->parent) {
+        path.push_back(node->name);
     }
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
-void postOrderTraversal(Node* root) {
-    if (!root) return;
 
-    for (Node* child : root->children) {
-        postOrderTraversal(child);
-    }
+/**
+ * @brief Displays the tree structure using indentation.
+ */
+void displayTree(Node* root, int depth) {
+    METRIC_SCOPE(Operation::Display);
+    BufferedWriter out(std::cout);
+    TreeDisplaySink sink(out, static_cast<size_t>(depth));
+    runTraversal(preOrder(root), sink);
+}
 
-    std::cout << root->level << ": " << root->name;
-    if (!root->commonName.empty()) {
-        std::cout << " [" << root->commonName << "]";
+static void freeSubtree(Node* root) {
+    // iterator sudah pindah dari node sebelum node itu dilepas
+    PostOrderIterator it(root), end;
+    while (it != end) {
+        Node* node = it->node;
+        ++it;
+        unindexNode(node);
+        releaseNode(node);
     }
-    std::cout << "\n";
 }
 
-void levelOrderTraversal(Node* root) {
+/**
+ * @brief Cleans up all dynamically allocated memory in the tree.
+ * Deleting the root releases the whole arena in one step; deleting a subtree
+ * unlinks it from its parent and the name index node by node.
+ */
+void deleteTree(Node* root) {
+    METRIC_SCOPE(Operation::DeleteTree);
     if (!root) return;
 
-    std::queue<Node*> q; 
-    q.push(root);
+    if (root->parent == nullptr) {
+        delete root->ctx;
+        return;
+    }
 
-    while (!q.empty()) {
-        Node* current = q.front();
-        q.pop();
+    detachChild(root);
+    freeSubtree(root);
+}
 
-        std::cout << current->level << ": " << current->name;
-        if (!current->commonName.empty()) {
-            std::cout << " [" << current->commonName << "]";
-        }
-        std::cout << "\n";
+// --- TRAVERSAL IMPLEMENTATIONS ---
 
-        for (Node* child : current->children) {
-            q.push(child);
-        }
-    }
+void preOrderTraversal(Node* root) {
+    METRIC_SCOPE(Operation::PreOrder);
+    BufferedWriter out(std::cout);
+    ListingSink sink(out);
+    runTraversal(preOrder(root), sink);
+}
+
+void postOrderTraversal(Node* root) {
+    METRIC_SCOPE(Operation::PostOrder);
+    BufferedWriter out(std::cout);
+    ListingSink sink(out);
+    runTraversal(postOrder(root), sink);
+}
+
+void levelOrderTraversal(Node* root) {
+    METRIC_SCOPE(Operation::LevelOrder);
+    BufferedWriter out(std::cout);
+    ListingSink sink(out);
+    runTraversal(levelOrder(root), sink);
 }
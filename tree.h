@@ -3,9 +3,15 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <memory>
 #include <algorithm> 
+#include "fold.h"
 
 //menjelaskan taxonomic yg fix untuk level strukturnya
 const std::vector<std::string> TAX_LEVELS = {
@@ -14,32 +20,233 @@ const std::vector<std::string> TAX_LEVELS = {
 const size_t REQUIRED_TAX_LEVELS = TAX_LEVELS.size(); 
 const size_t REQUIRED_TOTAL_INPUTS = TAX_LEVELS.size() + 1;
 
-// sruktur nodenya
-struct Node {
-    std::string name;             
-    std::string level;            
-    std::string commonName;       
-    std::string wikiLink;         // Link Wikipedia
+struct Node;
+struct TreeContext;
+
+// rank taksonomi, nilainya adalah index ke TAX_LEVELS
+enum class Rank : uint8_t {
+    Class, Order, Family, Genus, Species
+};
+
+const size_t RANK_COUNT = static_cast<size_t>(Rank::Species) + 1;
+
+inline const std::string& rankName(Rank rank) {
+    return TAX_LEVELS[static_cast<size_t>(rank)];
+}
+
+// nama yang sudah di-intern: pointer ke string milik StringPool tree-nya
+class InternedName {
+public:
+    InternedName() = default;
+    explicit InternedName(const std::string* str) : str_(str) {}
+
+    const std::string& str() const { return str_ ? *str_ : emptyString(); }
+    operator const std::string&() const { return str(); }
+    bool empty() const { return str().empty(); }
+
+private:
+    static const std::string& emptyString() {
+        static const std::string empty;
+        return empty;
+    }
+    const std::string* str_ = nullptr;
+};
+
+inline bool operator==(const InternedName& a, const std::string& b) { return a.str() == b; }
+inline bool operator!=(const InternedName& a, const std::string& b) { return a.str() != b; }
+inline std::ostream& operator<<(std::ostream& out, const InternedName& name) { return out << name.str(); }
+
+// indeks anak berdasarkan nama (case-insensitive). Selama anak <= SMALL_LIMIT, children
+// dicari linear (tanpa struktur tambahan); sesudahnya dibuat hash map. Key hash map menunjuk
+// ke nama anak yang sudah di-intern, jadi tidak ada salinan lowercase.
+struct ChildIndex {
+    static const size_t SMALL_LIMIT = 8;
+
+    std::unordered_map<std::string_view, Node*, FoldedHash, FoldedEqual>* wide = nullptr;
+
+    ChildIndex() = default;
+    ChildIndex(const ChildIndex&) = delete;
+    ChildIndex& operator=(const ChildIndex&) = delete;
+    ~ChildIndex() { delete wide; }
+
+    // children adalah children vector milik node yang sama; anak pertama dengan nama itu menang
+    Node* find(const std::vector<Node*>& children, std::string_view name) const;
+    // dipanggil sesudah child ditambahkan ke children
+    void insert(const std::vector<Node*>& children, Node* child);
+    void erase(const Node* child);
+    // sesudah anak dikeluarkan: anak lain dengan nama yang sama naik ke indeks
+    void restore(const std::vector<Node*>& children);
+};
+
+// agregat subtree (termasuk node itu sendiri), dijaga O(depth) oleh setiap attach/detach;
+// disimpan di TreeContext::subtreeStats
+struct SubtreeStats {
+    uint32_t perRank[RANK_COUNT] = {};  // jumlah node per rank, index = Rank
+    uint32_t linkedSpecies = 0;         // species yang punya wiki link
+    uint64_t contentHash = 0;           // isi node sendiri + hash semua anak (lihat contentHash())
+};
+
+// sruktur nodenya. Hanya field yang dipakai traversal & pencarian anak, supaya satu node
+// muat di satu cache line (platform 64-bit). Common name, wiki link, dan agregat subtree
+// disimpan per id node di kolom TreeContext (lihat nodeCommonName dkk.).
+struct alignas(64) Node {
+    InternedName name;             
     std::vector<Node*> children;  
+    ChildIndex childIndex;
+    Node* parent = nullptr;
+    TreeContext* ctx = nullptr;
+    uint32_t id = 0;              // slot di NodeArena milik ctx, juga index ke kolom metadata
+    Rank rank = Rank::Class;
 };
 
+// Satu kolom teks per id node. Nilai disalin ke heap, atau dipinjam dari storage lain
+// yang hidup selama tree (mis. snapshot yang di-mmap, lihat TreeContext::metadataBacking)
+// sehingga halaman file baru dibaca saat metadata itu benar-benar ditampilkan.
+class MetadataColumn {
+public:
+    std::string_view get(uint32_t id) const { return id < values_.size() ? values_[id] : std::string_view(); }
+    void set(uint32_t id, std::string_view value);
+    void borrow(uint32_t id, std::string_view value);
+    void clear(uint32_t id);
+    size_t bytes() const;   // array kolom + teks milik sendiri
+
+private:
+    void ensure(uint32_t id);
+
+    std::vector<std::string_view> values_;
+    std::vector<std::unique_ptr<char[]>> owned_;   // nullptr jika kosong atau dipinjam
+};
+
+// string pool per tree, setiap nama unik disimpan sekali
+class StringPool {
+public:
+    InternedName intern(const std::string& str);
+    size_t size() const { return strings_.size(); }
+    size_t bytes() const;   // perkiraan memori heap pool
+
+private:
+    std::unordered_set<std::string> strings_;
+};
+
+// alokator node per tree; semua node dilepas sekaligus saat arena dihancurkan
+class NodeArena {
+public:
+    NodeArena() = default;
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+    ~NodeArena();
+
+    Node* allocate();
+    void release(Node* node);
+    size_t liveCount() const { return live_; }
+    uint32_t idLimit() const { return nextId_; }   // semua id node < idLimit()
+    size_t reservedBytes() const;                  // chunk + daftar id bebas
+
+private:
+    struct Chunk;
+    std::vector<Chunk*> chunks_;
+    std::vector<uint32_t> freeIds_;
+    uint32_t nextId_ = 0;
+    size_t live_ = 0;
+};
+
+// state yang dibagi oleh semua node dalam satu tree
+struct TreeContext {
+    NodeArena nodes;
+    StringPool strings;
+    // data dingin per id node, hanya dibaca saat ditampilkan/diubah
+    MetadataColumn commonNames;
+    MetadataColumn wikiLinks;
+    std::vector<SubtreeStats> subtreeStats;
+    std::shared_ptr<const void> metadataBacking;   // pemilik storage yang dipinjam kolom metadata
+    uint64_t revision = 0;                          // naik setiap struktur atau metadata berubah
+    // nama taksonomi & common name (case-insensitive) -> node yang cocok.
+    // Key menunjuk ke nama/common name salah satu node di bucket-nya.
+    std::unordered_map<std::string_view, std::vector<Node*>, FoldedHash, FoldedEqual> nameIndex;
+};
+
+inline std::string_view nodeCommonName(const Node* node) { return node->ctx->commonNames.get(node->id); }
+inline std::string_view nodeWikiLink(const Node* node) { return node->ctx->wikiLinks.get(node->id); }
+inline const SubtreeStats& nodeSubtreeStats(const Node* node) { return node->ctx->subtreeStats[node->id]; }
+
 // --- FUNGSI UTILITY ---
 std::string toLower(const std::string& str); 
-Node* createNode(const std::string& name, const std::string& level);
+Node* createNode(TreeContext* ctx, const std::string& name, Rank rank);
+// Menyambung anak baru langsung di bawah parent tanpa lookup nama (dipakai loader snapshot).
+// parent == nullptr membuat root dari tree baru. Dengan TextStorage::Borrow, common name &
+// wiki link tidak disalin; storage-nya harus hidup selama tree (TreeContext::metadataBacking).
+enum class TextStorage : uint8_t { Copy, Borrow };
+Node* appendChild(Node* parent, const std::string& name, Rank rank,
+                  std::string_view commonName = std::string_view(), std::string_view wikiLink = std::string_view(),
+                  TextStorage storage = TextStorage::Copy);
+
+// Nama dari root tree sampai node (urutan sama dengan path addSpeciesPath)
+std::vector<std::string> nodePath(const Node* node);
+// true jika a dikunjungi sebelum b dalam pre-order tree mereka; false jika a == b. Dimaksudkan
+// untuk node dari tree yang sama. Node dari tree berbeda (mis. shard Forest lain) tidak punya
+// urutan pre-order bersama; hasilnya mengikuti alamat root masing-masing, sehingga tetap
+// konsisten untuk std::sort tetapi tidak bermakna.
+bool precedesInPreorder(const Node* a, const Node* b);
+
+// --- AGREGAT SUBTREE (O(1)) ---
+inline size_t speciesCount(const Node* node) { return nodeSubtreeStats(node).perRank[static_cast<size_t>(Rank::Species)]; }
+inline size_t linkedSpeciesCount(const Node* node) { return nodeSubtreeStats(node).linkedSpecies; }
+inline size_t descendantCount(const Node* node) {
+    size_t total = 0;
+    for (uint32_t count : nodeSubtreeStats(node).perRank) total += count;
+    return total - 1;
+}
+// Jumlah level di bawah node sampai node terdalam (0 untuk daun); rank sama dengan kedalaman
+inline size_t subtreeHeight(const Node* node) {
+    size_t deepest = static_cast<size_t>(node->rank);
+    for (size_t rank = deepest + 1; rank < RANK_COUNT; ++rank) {
+        if (nodeSubtreeStats(node).perRank[rank]) deepest = rank;
+    }
+    return deepest - static_cast<size_t>(node->rank);
+}
+// Hash isi subtree: nama (case-insensitive), rank, common name, wiki link, dan himpunan anak
+// (urutan anak tidak berpengaruh). Dua subtree dengan isi sama punya hash sama, juga antar
+// tree berbeda dalam satu proses; dipakai diffTrees untuk melewati subtree yang tidak berubah.
+inline uint64_t contentHash(const Node* node) { return nodeSubtreeStats(node).contentHash; }
+// Menghitung ulang semua agregat dengan traversal penuh dan membandingkannya dengan yang
+// tersimpan (untuk test). Selisih pertama dilaporkan ke std::cerr; false jika ada selisih.
+bool checkSubtreeStats(const Node* root);
 
 // --- FUNGSI CRUD: CREATE (Add) ---
 Node* addSpeciesPath(Node* root, const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink);
 
+// hasil satu insert, dipakai bulk loader untuk statistik
+enum class InsertResult { Added, Updated, Unchanged, Rejected };
+
+// Varian addSpeciesPath untuk bulk load: tanpa log ke std::cout, field berupa view
+// (mis. langsung ke buffer file) yang hanya disalin saat node baru dibuat.
+// Root dibuat lewat reference jika tree masih kosong.
+InsertResult insertSpeciesRecord(Node*& root, const std::vector<std::string_view>& path, std::string_view commonName, std::string_view wikiLink);
+
 // --- FUNGSI CRUD: READ (Search/Display) ---
 Node* searchNode(Node* root, const std::string& name);
+Node* findChild(Node* parent, const std::string& name);
+// Mengikuti path nama dari root ke bawah (path[0] adalah nama root), nullptr jika putus
+Node* findPath(Node* root, const std::vector<std::string>& path);
 void displayTree(Node* root, int depth = 0);
 
 // --- FUNGSI CRUD: UPDATE ---
 bool updateSpecies(Node* speciesNode, const std::string& newCommonName, const std::string& newWikiLink);
+// Varian tanpa log, dipakai saat replay dan batch
+bool updateSpeciesRecord(Node* speciesNode, std::string_view newCommonName, std::string_view newWikiLink);
 
 // --- FUNGSI CRUD: DELETE ---
-// Parent diperlukan untuk menghapus node dari children vector
+// Target dicari lewat name index dan dilepas lewat parent pointer, O(depth) per species.
+// Genus/Family/Order yang menjadi kosong ikut dihapus (tidak pernah root, tidak di atas root).
+// Parameter parent tidak dipakai lagi, hanya dipertahankan untuk kompatibilitas.
 Node* deleteSpecies(Node* root, const std::string& speciesName, Node* parent = nullptr);
+// Varian tanpa log, mengembalikan jumlah species yang dihapus
+size_t deleteSpeciesRecord(Node* root, const std::string& speciesName);
+// Menghapus semua species yang cocok dengan salah satu nama sekaligus (tanpa log);
+// setiap children vector yang terdampak dipadatkan sekali. Mengembalikan jumlah species yang dihapus.
+// removedPerName (opsional) diisi jumlah per nama; species yang cocok dengan beberapa nama dihitung
+// untuk nama pertama, jadi hasilnya sama dengan deleteSpeciesRecord untuk setiap nama berurutan.
+size_t deleteSpeciesBatch(Node* root, const std::vector<std::string>& speciesNames, std::vector<size_t>* removedPerName = nullptr);
 void deleteTree(Node* root);
 
 // --- FUNGSI TRAVERSAL ---
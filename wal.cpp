@@ -0,0 +1,436 @@
+#include "wal.h"
+#include "snapshot.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+static const uint32_t MAX_RECORD_PAYLOAD = 64u << 20;
+
+// --- ENCODING ---
+
+static uint32_t crc32Update(uint32_t crc, const char* data, size_t size) {
+    static uint32_t table[256];
+    static bool ready = [] {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)ready;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putString(std::string& out, const std::string& str) {
+    uint32_t length = static_cast<uint32_t>(str.size());
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(str);
+}
+
+static bool getString(std::string_view& in, std::string& out) {
+    uint32_t length;
+    if (in.size() < sizeof(length)) return false;
+    std::memcpy(&length, in.data(), sizeof(length));
+    in.remove_prefix(sizeof(length));
+    if (in.size() < length) return false;
+    out.assign(in.data(), length);
+    in.remove_prefix(length);
+    return true;
+}
+
+static std::string encodeSpecies(LogOp op, const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink) {
+    std::string body(1, static_cast<char>(op));
+    for (const std::string& name : path) putString(body, name);
+    putString(body, commonName);
+    putString(body, wikiLink);
+    return body;
+}
+
+static bool decodeRecord(std::string_view payload, LogRecord& record) {
+    if (payload.size() < sizeof(uint64_t) + 1) return false;
+    std::memcpy(&record.lsn, payload.data(), sizeof(uint64_t));
+    payload.remove_prefix(sizeof(uint64_t));
+    record.op = static_cast<LogOp>(payload[0]);
+    payload.remove_prefix(1);
+
+    switch (record.op) {
+        case LogOp::Add:
+        case LogOp::Update:
+            record.path.assign(REQUIRED_TAX_LEVELS, std::string());
+            for (std::string& name : record.path) {
+                if (!getString(payload, name)) return false;
+            }
+            return getString(payload, record.commonName) && getString(payload, record.wikiLink) && payload.empty();
+        case LogOp::Delete:
+            return getString(payload, record.name) && payload.empty();
+    }
+    return false;
+}
+
+static bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief Walks the raw records of a log file; stops at the first torn or corrupt record.
+ * @return Byte offset just past the last intact record.
+ */
+template <typename Visitor>
+static uint64_t scanLog(std::FILE* file, Visitor visit) {
+    uint64_t goodOffset = 0;
+    std::string record;
+    while (true) {
+        char header[RECORD_HEADER_SIZE];
+        if (std::fread(header, 1, sizeof(header), file) != sizeof(header)) break;
+
+        uint32_t length, crc;
+        std::memcpy(&length, header, sizeof(length));
+        std::memcpy(&crc, header + sizeof(length), sizeof(crc));
+        if (length > MAX_RECORD_PAYLOAD) break;
+
+        record.assign(header, sizeof(header));
+        record.resize(sizeof(header) + length);
+        if (std::fread(&record[sizeof(header)], 1, length, file) != length) break;
+        if (crc32Update(0, record.data() + sizeof(header), length) != crc) break;
+
+        std::string_view payload(record.data() + sizeof(header), length);
+        uint64_t lsn = 0;
+        if (length >= sizeof(lsn)) std::memcpy(&lsn, payload.data(), sizeof(lsn));
+        if (!visit(std::string_view(record), payload, lsn)) break;
+        goodOffset += record.size();
+    }
+    return goodOffset;
+}
+
+// --- OPERATION LOG ---
+
+bool OperationLog::open(const std::string& filename, uint64_t lastLsn, const Options& options) {
+    close();
+
+    file_ = std::fopen(filename.c_str(), "ab");
+    if (!file_) {
+        std::cerr << "[ERROR] Cannot open operation log '" << filename << "'.\n";
+        return false;
+    }
+    filename_ = filename;
+    options_ = options;
+    appendedLsn_ = durableLsn_ = lastLsn;
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(filename, error);
+    logBytes_ = error ? 0 : size;
+    stopping_ = false;
+    flusherDone_ = false;
+    failed_ = false;
+    open_ = true;
+    flusher_ = std::thread(&OperationLog::flusherLoop, this);
+    return true;
+}
+
+void OperationLog::close() {
+    joinCompaction();
+    if (!open_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    pendingCv_.notify_all();
+    flusher_.join();
+
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    open_ = false;
+    durableCv_.notify_all();
+}
+
+uint64_t OperationLog::logAdd(const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink) {
+    return isOpen() ? append(encodeSpecies(LogOp::Add, path, commonName, wikiLink)) : 0;
+}
+
+uint64_t OperationLog::logUpdate(const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink) {
+    return isOpen() ? append(encodeSpecies(LogOp::Update, path, commonName, wikiLink)) : 0;
+}
+
+uint64_t OperationLog::logDelete(const std::string& name) {
+    if (!isOpen()) return 0;
+    std::string body(1, static_cast<char>(LogOp::Delete));
+    putString(body, name);
+    return append(body);
+}
+
+/**
+ * @brief Frames a record with its LSN and CRC and queues it for the flusher.
+ */
+uint64_t OperationLog::append(const std::string& body) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t lsn = ++appendedLsn_;
+
+    uint32_t length = static_cast<uint32_t>(sizeof(lsn) + body.size());
+    uint32_t crc = crc32Update(crc32Update(0, reinterpret_cast<const char*>(&lsn), sizeof(lsn)), body.data(), body.size());
+    pending_.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    pending_.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    pending_.append(reinterpret_cast<const char*>(&lsn), sizeof(lsn));
+    pending_.append(body);
+
+    lock.unlock();
+    pendingCv_.notify_one();
+    return lsn;
+}
+
+bool OperationLog::waitDurable(uint64_t lsn) {
+    if (lsn == 0) return true;
+    std::unique_lock<std::mutex> lock(mutex_);
+    durableCv_.wait(lock, [&] { return durableLsn_ >= lsn || failed_ || flusherDone_; });
+    return durableLsn_ >= lsn;
+}
+
+bool OperationLog::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+uint64_t OperationLog::lastLsn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return appendedLsn_;
+}
+
+/**
+ * @brief Group commit: waits briefly so concurrent operations share one write + fsync.
+ */
+void OperationLog::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        pendingCv_.wait(lock, [&] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) break;
+        if (!stopping_) {
+            pendingCv_.wait_for(lock, options_.commitInterval,
+                                [&] { return stopping_ || pending_.size() >= options_.maxBatchBytes; });
+        }
+
+        std::string batch;
+        batch.swap(pending_);
+        uint64_t batchLsn = appendedLsn_;
+        // sesudah gagal, record berikutnya tidak ditulis: recovery berhenti di record yang
+        // terpotong, jadi record sesudahnya tidak akan pernah dibaca lagi
+        if (failed_) continue;
+        lock.unlock();
+
+        bool ok;
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex_);
+            ok = file_ != nullptr && std::fwrite(batch.data(), 1, batch.size(), file_) == batch.size() && syncFile(file_);
+        }
+        if (!ok) {
+            std::cerr << "[ERROR] Failed to write operation log '" << filename_ << "'. Further changes are refused.\n";
+        }
+
+        lock.lock();
+        if (ok) {
+            durableLsn_ = batchLsn;
+            logBytes_ += batch.size();
+        } else {
+            failed_ = true;
+        }
+        durableCv_.notify_all();
+    }
+    flusherDone_ = true;
+    durableCv_.notify_all();
+}
+
+bool OperationLog::needsCompaction() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_ && !compacting_ && logBytes_ >= options_.compactThresholdBytes;
+}
+
+void OperationLog::compact(std::vector<char> image, uint64_t checkpointLsn, const std::string& snapshotFile, bool background) {
+    if (!isOpen()) return;
+    joinCompaction();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        compacting_ = true;
+    }
+
+    if (background) {
+        compactor_ = std::thread(&OperationLog::runCompaction, this, std::move(image), checkpointLsn, snapshotFile);
+    } else {
+        runCompaction(std::move(image), checkpointLsn, snapshotFile);
+    }
+}
+
+void OperationLog::joinCompaction() {
+    if (compactor_.joinable()) compactor_.join();
+}
+
+/**
+ * @brief Writes the checkpoint, then rewrites the log keeping only records newer than it.
+ * A crash at any point leaves either the old or the new checkpoint plus a log that covers it.
+ */
+void OperationLog::runCompaction(std::vector<char> image, uint64_t checkpointLsn, std::string snapshotFile) {
+    bool ok = writeSnapshotImage(image, snapshotFile);
+    std::vector<char>().swap(image);
+
+    if (ok) {
+        std::lock_guard<std::mutex> fileLock(fileMutex_);
+        std::string tempName = filename_ + ".tmp";
+        std::FILE* out = std::fopen(tempName.c_str(), "wb");
+        std::FILE* in = std::fopen(filename_.c_str(), "rb");
+        uint64_t kept = 0;
+
+        ok = out && in;
+        if (ok) {
+            scanLog(in, [&](std::string_view raw, std::string_view, uint64_t lsn) {
+                if (lsn > checkpointLsn) {
+                    ok = ok && std::fwrite(raw.data(), 1, raw.size(), out) == raw.size();
+                    kept += raw.size();
+                }
+                return true;
+            });
+            ok = syncFile(out) && ok;
+        }
+        if (in) std::fclose(in);
+        if (out) ok = (std::fclose(out) == 0) && ok;
+
+        if (ok) {
+            std::fclose(file_);
+            std::error_code error;
+            std::filesystem::rename(tempName, filename_, error);
+            ok = !error;
+            file_ = std::fopen(filename_.c_str(), "ab");
+            if (!file_) {
+                std::cerr << "[ERROR] Cannot reopen operation log '" << filename_ << "'.\n";
+            }
+        } else {
+            std::remove(tempName.c_str());
+        }
+
+        if (ok) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            logBytes_ = kept;
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "[ERROR] Checkpoint to '" << snapshotFile << "' failed; the operation log was kept.\n";
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    compacting_ = false;
+}
+
+// --- RECOVERY ---
+
+bool readLogRecords(const std::string& filename, std::vector<LogRecord>& records) {
+    records.clear();
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return true;   // belum ada log
+
+    // CRC cocok tetapi tidak bisa di-decode (op dari versi lebih baru, bug decoder): record itu
+    // benar-benar ditulis, jadi bukan ekor yang terpotong dan file tidak boleh dipotong
+    bool undecodable = false;
+    uint64_t undecodableLsn = 0;
+    uint64_t goodOffset = scanLog(file, [&](std::string_view, std::string_view payload, uint64_t lsn) {
+        LogRecord record;
+        if (!decodeRecord(payload, record)) {
+            undecodable = true;
+            undecodableLsn = lsn;
+            return false;
+        }
+        records.push_back(std::move(record));
+        return true;
+    });
+    std::fclose(file);
+
+    if (undecodable) {
+        std::cerr << "[ERROR] Operation log '" << filename << "' has an intact record (#" << undecodableLsn << " at byte "
+                  << goodOffset << ") this build cannot read. The log was left untouched.\n";
+        records.clear();
+        return false;
+    }
+
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(filename, error);
+    if (!error && size > goodOffset) {
+        std::cerr << "[WARN] Discarding " << (size - goodOffset) << " bytes of incomplete operation log '"
+                  << filename << "'.\n";
+        std::filesystem::resize_file(filename, goodOffset, error);
+        if (error) {
+            std::cerr << "[ERROR] Cannot truncate operation log '" << filename << "'.\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void applyLogRecord(Node*& root, const LogRecord& record) {
+    switch (record.op) {
+        case LogOp::Add: {
+            std::vector<std::string_view> path(record.path.begin(), record.path.end());
+            insertSpeciesRecord(root, path, record.commonName, record.wikiLink);
+            break;
+        }
+        case LogOp::Update:
+            updateSpeciesRecord(findPath(root, record.path), record.commonName, record.wikiLink);
+            break;
+        case LogOp::Delete:
+            deleteSpeciesRecord(root, record.name);
+            break;
+    }
+}
+
+bool recoverTree(const std::string& snapshotFile, const std::string& logFile, Node*& root, uint64_t& lastLsn) {
+    root = nullptr;
+    lastLsn = 0;
+
+    std::error_code error;
+    if (std::filesystem::exists(snapshotFile, error)) {
+#ifdef _WIN32
+        // checkpoint mengganti file ini, dan Windows menolak mengganti file yang masih di-map
+        SnapshotView snapshot;
+        if (!snapshot.open(snapshotFile)) return false;
+        root = loadSnapshotTree(snapshot);
+        lastLsn = snapshot.checkpointLsn();
+#else
+        // metadata dipinjam dari mapping; rename saat checkpoint tidak mengubah file yang di-map
+        auto snapshot = std::make_shared<SnapshotView>();
+        if (!snapshot->open(snapshotFile)) return false;
+        lastLsn = snapshot->checkpointLsn();
+        root = loadSnapshotTree(std::shared_ptr<const SnapshotView>(std::move(snapshot)));
+#endif
+    }
+
+    std::vector<LogRecord> records;
+    if (!readLogRecords(logFile, records)) return false;
+
+    size_t replayed = 0;
+    for (const LogRecord& record : records) {
+        if (record.lsn <= lastLsn) continue;   // sudah termasuk di checkpoint
+
+        applyLogRecord(root, record);
+        lastLsn = record.lsn;
+        ++replayed;
+    }
+
+    if (replayed > 0) {
+        std::cout << "[INFO] Replayed " << replayed << " logged operations from '" << logFile << "'.\n";
+    }
+    return true;
+}
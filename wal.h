@@ -0,0 +1,110 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include "tree.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Operation log (write-ahead log) untuk add/update/delete dari menu.
+// Setiap record: uint32_t panjang payload, uint32_t CRC32, lalu payload
+// (uint64_t LSN, uint8_t LogOp, field string dengan prefix panjang uint32_t).
+// Record ditulis oleh satu thread flusher yang mengumpulkan beberapa operasi
+// sekaligus sebelum fsync (group commit).
+enum class LogOp : uint8_t {
+    Add = 1,      // path Class..Species, common name, wiki link
+    Update = 2,   // path Class..Species, common name baru, wiki link baru
+    Delete = 3    // nama seperti yang diberikan ke deleteSpecies
+};
+
+struct LogRecord {
+    uint64_t lsn = 0;
+    LogOp op = LogOp::Add;
+    std::vector<std::string> path;
+    std::string commonName;
+    std::string wikiLink;
+    std::string name;
+};
+
+class OperationLog {
+public:
+    struct Options {
+        std::chrono::milliseconds commitInterval{5};       // waktu tunggu untuk mengumpulkan satu batch
+        size_t maxBatchBytes = 1 << 20;                      // batch penuh langsung ditulis
+        uint64_t compactThresholdBytes = 64ull << 20;       // ukuran log yang memicu checkpoint baru
+    };
+
+    OperationLog() = default;
+    OperationLog(const OperationLog&) = delete;
+    OperationLog& operator=(const OperationLog&) = delete;
+    ~OperationLog() { close(); }
+
+    // lastLsn: LSN terakhir yang sudah ada (hasil recoverTree), record baru mulai dari lastLsn + 1
+    bool open(const std::string& filename, uint64_t lastLsn, const Options& options);
+    bool open(const std::string& filename, uint64_t lastLsn) { return open(filename, lastLsn, Options()); }
+    void close();
+    bool isOpen() const { return open_; }
+
+    // Mengembalikan LSN record; 0 jika log tidak dibuka (mode tanpa durability)
+    uint64_t logAdd(const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink);
+    uint64_t logUpdate(const std::vector<std::string>& path, const std::string& commonName, const std::string& wikiLink);
+    uint64_t logDelete(const std::string& name);
+
+    // Menunggu sampai record dengan LSN ini sudah di-fsync. false jika penulisan log gagal
+    // (atau log ditutup) sebelum itu: perubahannya tidak boleh dilaporkan berhasil.
+    bool waitDurable(uint64_t lsn);
+    // Penulisan log pernah gagal; sesudah itu tidak ada record yang menjadi durable lagi
+    bool failed() const;
+    uint64_t lastLsn() const;
+
+    // Checkpoint: image snapshot yang mencakup semua record sampai checkpointLsn ditulis
+    // ke snapshotFile, lalu record lama dibuang dari log. background = true menjalankannya
+    // di thread terpisah (paling banyak satu checkpoint berjalan sekaligus).
+    bool needsCompaction() const;
+    void compact(std::vector<char> image, uint64_t checkpointLsn, const std::string& snapshotFile, bool background);
+
+private:
+    uint64_t append(const std::string& payload);
+    void flusherLoop();
+    void runCompaction(std::vector<char> image, uint64_t checkpointLsn, std::string snapshotFile);
+    void joinCompaction();
+
+    std::string filename_;
+    Options options_;
+    std::FILE* file_ = nullptr;         // diganti oleh checkpoint, selalu diakses lewat fileMutex_
+    bool open_ = false;                 // hanya diubah oleh open()/close()
+
+    mutable std::mutex mutex_;          // melindungi semua field di bawah ini kecuali file_
+    std::condition_variable pendingCv_;
+    std::condition_variable durableCv_;
+    std::string pending_;               // record yang belum ditulis
+    uint64_t appendedLsn_ = 0;
+    uint64_t durableLsn_ = 0;
+    uint64_t logBytes_ = 0;
+    bool stopping_ = false;
+    bool flusherDone_ = false;          // flusher sudah berhenti, tidak ada lagi yang menjadi durable
+    bool failed_ = false;               // write/fsync pernah gagal (tetap sampai log dibuka ulang)
+    bool compacting_ = false;
+
+    std::mutex fileMutex_;              // dipegang saat menulis ke file_ atau mengganti file_
+    std::thread flusher_;
+    std::thread compactor_;
+};
+
+// --- RECOVERY ---
+// Membaca semua record yang utuh; ekor yang terpotong/rusak (crash di tengah write) dipotong dari file.
+// Record dengan CRC yang cocok tetapi tidak bisa di-decode membuat recovery gagal (false) dan
+// file tidak diubah, karena record itu dan semua sesudahnya sudah pernah dilaporkan durable.
+bool readLogRecords(const std::string& filename, std::vector<LogRecord>& records);
+// Menerapkan satu record ke tree tanpa pesan ke layar (replay, ConcurrentTree)
+void applyLogRecord(Node*& root, const LogRecord& record);
+// Memuat snapshot (checkpoint) lalu memutar ulang record dengan LSN > checkpoint.
+// lastLsn diisi dengan LSN terbesar yang sudah diterapkan. false jika snapshot/log tidak bisa dibaca.
+bool recoverTree(const std::string& snapshotFile, const std::string& logFile, Node*& root, uint64_t& lastLsn);
+
+#endif